@@ -0,0 +1,182 @@
+#include "LargeUnsignedDigitGenerator.h"
+#include <stdexcept>
+#include <cstring>
+#include <utility>
+
+
+// Object Initializing Constructor
+// Only the leading limit digits are produced. Throws for a base outside 2 to 36
+LargeUnsignedDigitGenerator::LargeUnsignedDigitGenerator(const LargeUnsignedInteger& num, int base, unsigned int limit) :
+		depth			{0},
+		radix			{static_cast<unsigned int>(base)},
+		buf				{nullptr},
+		buf_capacity	{0},
+		buf_pos			{0},
+		buf_end			{0},
+		zeros			{0},
+		leading			{!num.is_zero()},
+		limit			{limit}
+{
+	unsigned int len = num.max_chars(base);
+
+	if(len == 0)
+		throw std::invalid_argument("Base must be from 2 to 36.");
+
+	// Zero is the only value whose leading zero is kept
+	if(num.is_zero()) {
+		parts[depth] = num;
+		part_lens[depth++] = 1;
+		return;
+	}
+
+	// Leading digits only: divide once by radix^s, dropping all but a chunk of guard digits beyond limit, rather than
+	// splitting down to them. max_chars() is at most 2 over the digits of num, so limit + chunk_digits are always kept
+	unsigned int chunk_digits = LargeUnsignedInteger::RADIX_CHUNK_DIGITS[radix];
+	unsigned int kept = chunk_digits + 3;
+	unsigned int s = len > kept  &&  len - kept > limit ? len - kept - limit : 0;	// digits dropped
+
+	if(s > 0  &&  num.num_segments >= LargeUnsignedInteger::DEC_DC_THRESHOLD) {
+		// Quotient words, then precision of the truncated power that keeps its estimate at most 1 too large
+		unsigned int qn = (len - s + chunk_digits - 1) / chunk_digits;
+		ull_t shift;
+		LargeUnsignedInteger power = power_high(radix, s, qn + 2, shift);
+
+		// An estimate 1 too large differs only in the guard digits, unless they are all zero. Then divide exactly
+		parts[depth] = (num >> shift) / power;
+		if((parts[depth] % LargeUnsignedInteger::RADIX_CHUNK[radix]).is_zero())
+			parts[depth] = num / LargeUnsignedInteger::pow(radix, s);
+
+		part_lens[depth++] = len - s;
+	}
+	else {
+		parts[depth] = num;
+		part_lens[depth++] = len;
+	}
+}
+
+
+// Destructor
+LargeUnsignedDigitGenerator::~LargeUnsignedDigitGenerator() {
+	delete[] buf;
+}
+
+
+// Return whether all digits have been produced
+bool LargeUnsignedDigitGenerator::done() const {
+	return limit == 0  ||  (depth == 0  &&  zeros == 0  &&  buf_pos == buf_end);
+}
+
+
+// Write up to len of the next digits into first, and return how many were written
+// Fewer than len are written only once done(). Stopping early leaves the remaining parts unconverted
+unsigned int LargeUnsignedDigitGenerator::next(char* first, unsigned int len) {
+	unsigned int count = 0;
+	unsigned int n;
+
+	if(len > limit)
+		len = limit;
+
+	while(count < len) {
+		if(zeros > 0) {
+			if(leading) {
+				zeros = 0;
+				continue;
+			}
+
+			n = zeros < len - count ? zeros : len - count;
+			std::memset(first + count, '0', n);
+			zeros -= n;
+			count += n;
+		}
+		else if(buf_pos < buf_end) {
+			if(leading) {
+				while(buf_pos < buf_end  &&  buf[buf_pos] == '0')
+					++buf_pos;
+				if(buf_pos == buf_end)
+					continue;
+				leading = false;
+			}
+
+			n = buf_end - buf_pos < len - count ? buf_end - buf_pos : len - count;
+			std::memcpy(first + count, buf + buf_pos, n);
+			buf_pos += n;
+			count += n;
+		}
+		else if(!refill())
+			break;
+	}
+
+	limit -= count;
+	return count;
+}
+
+
+// Convert the most-significant pending part into buf. Returns false if none is left
+// Splits the part by cached radix powers until its leading piece is below DEC_DC_THRESHOLD, keeping the rest pending
+bool LargeUnsignedDigitGenerator::refill() {
+	if(depth == 0)
+		return false;
+
+	--depth;
+	LargeUnsignedInteger u{std::move(parts[depth])};
+	unsigned int len = part_lens[depth];
+
+	while(u.num_segments >= LargeUnsignedInteger::DEC_DC_THRESHOLD  &&  u.num_segments >= 2) {
+		// Largest cached power with at most half the words of u, as in get_str()
+		unsigned int k = 0;
+		while(k+1 < LargeUnsignedInteger::RADIX_POWERS_MAX  &&  LargeUnsignedInteger::radix_power(radix, k+1).num_segments * 2 <= u.num_segments)
+			++k;
+
+		quot_rem qr = u.div_mod(LargeUnsignedInteger::radix_power(radix, k));
+
+		unsigned int low_len = LargeUnsignedInteger::RADIX_CHUNK_DIGITS[radix] << k;	// digits of remainder
+
+		parts[depth] = std::move(qr.second);
+		part_lens[depth++] = low_len;
+
+		u = std::move(qr.first);
+		len -= low_len;
+	}
+
+	// Padding beyond the digits u can have is counted rather than stored, so buf stays basecase-sized
+	unsigned int m = u.max_chars(radix);
+	if(m > len)
+		m = len;
+	zeros = len - m;
+
+	if(m > buf_capacity) {
+		delete[] buf;
+		buf = new char[m];
+		buf_capacity = m;
+	}
+
+	LargeUnsignedInteger::get_str_basecase(buf, m, u, radix);
+	buf_pos = 0;
+	buf_end = m;
+
+	return true;
+}
+
+
+// Return the top p words of radix^exp, with shift set to the bits dropped below them. Truncated after each step of
+// binary powering, so p words cost O(p^2 log exp) and the result is below radix^exp by a relative error under 2^(96 - 64p)
+LargeUnsignedInteger LargeUnsignedDigitGenerator::power_high(unsigned int radix, unsigned int exp, unsigned int p, ull_t& shift) {
+	LargeUnsignedInteger r{static_cast<ull_t>(radix)};
+	ull_t t;
+	shift = 0;
+
+	for(int i = 30 - __builtin_clz(exp);  i >= 0;  --i) {
+		r = r.square();
+		shift *= 2;
+		if(exp >> i & 1)
+			r *= static_cast<ull_t>(radix);
+
+		if(r.num_segments > p) {
+			t = (ull_t)(r.num_segments - p) * LargeUnsignedInteger::ULL_BITS;
+			r >>= t;
+			shift += t;
+		}
+	}
+
+	return r;
+}
@@ -0,0 +1,46 @@
+#ifndef LARGEUNSIGNEDDIGITGENERATOR_H_
+#define LARGEUNSIGNEDDIGITGENERATOR_H_
+
+
+#include "LargeUnsignedInteger.h"
+#include <climits>
+
+
+
+// Produces the digits of a value most-significant first, in pieces on demand, without holding the whole string
+// Splits by the cached radix powers like to_chars(), but only converts the leading piece still pending
+// Given a limit, only the leading digits are produced, from one short division by a truncated radix power
+class LargeUnsignedDigitGenerator {
+private:
+	static const unsigned int PARTS_MAX = 66;	// at most two pending parts per cached radix power
+
+	LargeUnsignedInteger parts[PARTS_MAX];		// pending values, most-significant on top
+	unsigned int part_lens[PARTS_MAX];			// digits of each pending value, zero-padded
+	unsigned int depth;							// number of pending parts
+	unsigned int radix;
+
+	char* buf;									// digits of the current basecase part
+	unsigned int buf_capacity;
+	unsigned int buf_pos;						// next character of buf
+	unsigned int buf_end;
+	unsigned int zeros;							// padding zeros before buf[buf_pos]
+	bool leading;								// still skipping leading zeros
+	unsigned int limit;							// digits still wanted
+
+	bool refill();
+	static LargeUnsignedInteger power_high(unsigned int radix, unsigned int exp, unsigned int p, ull_t& shift);
+
+
+public:
+	LargeUnsignedDigitGenerator(const LargeUnsignedInteger& num, int base = 10, unsigned int limit = UINT_MAX);
+	~LargeUnsignedDigitGenerator();
+
+	LargeUnsignedDigitGenerator(const LargeUnsignedDigitGenerator&) = delete;
+	LargeUnsignedDigitGenerator& operator=(const LargeUnsignedDigitGenerator&) = delete;
+
+	bool done() const;
+	unsigned int next(char* first, unsigned int len);
+};
+
+
+#endif /* LARGEUNSIGNEDDIGITGENERATOR_H_ */
@@ -0,0 +1,126 @@
+#include "LargeUnsignedDigitParser.h"
+#include <stdexcept>
+#include <utility>
+
+
+// Object Initializing Constructor
+// Throws for a base outside 2 to 36
+LargeUnsignedDigitParser::LargeUnsignedDigitParser(int base) :
+		depth			{0},
+		radix			{static_cast<unsigned int>(base)},
+		bits			{0},
+		block_digits	{0},
+		block_len		{0},
+		has_digits		{false}
+{
+	if(base < 2  ||  base > 36)
+		throw std::invalid_argument("Base must be from 2 to 36.");
+
+	if((radix & (radix-1)) == 0)
+		bits = __builtin_ctz(radix);
+
+	block_digits = LargeUnsignedInteger::RADIX_CHUNK_DIGITS[radix] << BLOCK_K;
+}
+
+
+// Return whether no digits have been pushed since construction or the last finish()
+bool LargeUnsignedDigitParser::empty() const {
+	return !has_digits;
+}
+
+
+// Take the digits at the start of [first, last), and return a pointer past them
+// A pointer before last means a non-digit was found there. Later calls continue the same number
+const char* LargeUnsignedDigitParser::push(const char* first, const char* last) {
+	unsigned char d;
+
+	for(;  first != last;  ++first) {
+		d = LargeUnsignedInteger::digit_value(*first);
+		if(d >= radix)
+			break;
+
+		block[block_len++] = d;
+		has_digits = true;
+
+		if(block_len == block_digits)
+			push_block();
+	}
+
+	return first;
+}
+
+
+// Return the value of the digits pushed, and reset to no digits
+LargeUnsignedInteger LargeUnsignedDigitParser::finish() {
+	LargeUnsignedInteger u;
+
+	// Join the parts, most-significant first. Each has exactly its level's digits
+	if(depth > 0) {
+		u = std::move(parts[0]);
+		for(unsigned int i = 1;  i < depth;  ++i)
+			join(u, parts[i], (ull_t)block_digits << part_levels[i], LargeUnsignedInteger::radix_power(radix, BLOCK_K + part_levels[i]));
+	}
+
+	// Partial last block
+	if(block_len > 0) {
+		LargeUnsignedInteger tail;
+		convert(tail, block, block_len);
+
+		if(depth > 0)
+			join(u, tail, block_len, bits ? LargeUnsignedInteger{} : LargeUnsignedInteger::pow(radix, block_len));
+		else
+			u = tail;
+	}
+
+	for(unsigned int i = 0;  i < depth;  ++i)
+		parts[i] = 0;
+	depth = 0;
+	block_len = 0;
+	has_digits = false;
+
+	return u;
+}
+
+
+// Convert the full block onto the parts, joining the top two while they hold the same number of blocks
+void LargeUnsignedDigitParser::push_block() {
+	if(depth == PARTS_MAX)
+		throw std::length_error("Too many digits.");
+
+	convert(parts[depth], block, block_len);
+	part_levels[depth++] = 0;
+	block_len = 0;
+
+	unsigned int level;
+	while(depth >= 2  &&  part_levels[depth-1] == part_levels[depth-2]) {
+		level = part_levels[depth-1];
+		join(parts[depth-2], parts[depth-1], (ull_t)block_digits << level, LargeUnsignedInteger::radix_power(radix, BLOCK_K + level));
+
+		parts[depth-1] = 0;
+		--depth;
+		part_levels[depth-1] = level + 1;
+	}
+}
+
+
+// Set u to the value of len digit values of sp
+void LargeUnsignedDigitParser::convert(LargeUnsignedInteger& u, const char* sp, unsigned int len) const {
+	if(bits)
+		u.set_str_pow2(sp, len, bits);
+	else
+		u.set_str(sp, len, radix);
+}
+
+
+// Set high to high * radix^digits + low, where power is radix^digits. Powers of two shift instead, without power
+// low is used as scratch, and its array is moved into high rather than copied
+void LargeUnsignedDigitParser::join(LargeUnsignedInteger& high, LargeUnsignedInteger& low, ull_t digits, const LargeUnsignedInteger& power) const {
+	if(bits) {
+		high <<= digits * bits;
+		high += low;
+	}
+	else {
+		low.addmul(high, power);
+		high = std::move(low);
+	}
+}
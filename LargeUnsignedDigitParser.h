@@ -0,0 +1,44 @@
+#ifndef LARGEUNSIGNEDDIGITPARSER_H_
+#define LARGEUNSIGNEDDIGITPARSER_H_
+
+
+#include "LargeUnsignedInteger.h"
+
+
+
+// Accumulates digits pushed in pieces, most-significant first, without holding the whole string
+// Digits are converted in fixed-size blocks, which are joined pairwise at cached radix powers like a binary counter
+class LargeUnsignedDigitParser {
+private:
+	static const unsigned int BLOCK_K = 7;		// blocks of RADIX_CHUNK_DIGITS << BLOCK_K digits
+	static const unsigned int PARTS_MAX = LargeUnsignedInteger::RADIX_POWERS_MAX - BLOCK_K;	// one part per block size, up to the largest cached radix power
+
+	LargeUnsignedInteger parts[PARTS_MAX];		// converted blocks, most-significant at the bottom
+	unsigned int part_levels[PARTS_MAX];		// each part holds 2^level blocks
+	unsigned int depth;							// number of parts
+	unsigned int radix;
+	unsigned int bits;							// log2(radix) for powers of two, else 0
+
+	char block[64 << BLOCK_K];					// digit values of the block being filled
+	unsigned int block_digits;					// digits per full block
+	unsigned int block_len;
+	bool has_digits;
+
+	void push_block();
+	void convert(LargeUnsignedInteger& u, const char* sp, unsigned int len) const;
+	void join(LargeUnsignedInteger& high, LargeUnsignedInteger& low, ull_t digits, const LargeUnsignedInteger& power) const;
+
+
+public:
+	LargeUnsignedDigitParser(int base = 10);
+
+	LargeUnsignedDigitParser(const LargeUnsignedDigitParser&) = delete;
+	LargeUnsignedDigitParser& operator=(const LargeUnsignedDigitParser&) = delete;
+
+	bool empty() const;
+	const char* push(const char* first, const char* last);
+	LargeUnsignedInteger finish();
+};
+
+
+#endif /* LARGEUNSIGNEDDIGITPARSER_H_ */
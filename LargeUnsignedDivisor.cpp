@@ -0,0 +1,198 @@
+#include "LargeUnsignedDivisor.h"
+#include <stdexcept>
+#include <utility>
+
+
+// Tunable threshold, in words. Barrett's two full products measured no faster than long division from 32 up to
+// 2000 words, so it's kept for long divisors only
+unsigned int LargeUnsignedDivisor::BARRETT_THRESHOLD = 1000;
+
+
+// Object Initializing Constructor
+LargeUnsignedDivisor::LargeUnsignedDivisor(const LargeUnsignedInteger& num) :
+		value		{num},
+		shift		{0},
+		inv			{0},
+		recip_bits	{0}
+{
+	init();
+}
+
+
+// Scalar Initializing Constructor
+LargeUnsignedDivisor::LargeUnsignedDivisor(ull_t num) :
+		value		{num},
+		shift		{0},
+		inv			{0},
+		recip_bits	{0}
+{
+	init();
+}
+
+
+// Precompute normalization and reciprocals of value
+void LargeUnsignedDivisor::init() {
+	// Check for zero divisor
+	if(value.is_zero())
+		throw std::invalid_argument("Division by zero.");
+
+	unsigned int n = value.num_segments;
+
+	// Normalize, so that the top bit is set
+	shift = __builtin_clzll(value.arr[n-1]);
+	norm = shift ? value << static_cast<ull_t>(shift) : value;
+	inv = LargeUnsignedInteger::invert_limb(norm.arr[n-1]);
+
+	// Barrett constant, good for dividends up to twice the divisor length
+	if(n >= BARRETT_THRESHOLD) {
+		recip_bits = 2 * n * LargeUnsignedInteger::ULL_BITS;
+		recip = value.reciprocal(recip_bits);
+	}
+
+	// Quotient scratch for dividends up to twice the divisor length
+	if(n > 1)
+		scratch.reserve(n+1);
+}
+
+
+// Get divisor
+const LargeUnsignedInteger& LargeUnsignedDivisor::get_value() const {
+	return value;
+}
+
+
+// Get divisor size in words
+unsigned int LargeUnsignedDivisor::get_size() const {
+	return value.num_segments;
+}
+
+
+// Return the quotient & remainder of a LargeUnsignedInteger object divided by this
+quot_rem LargeUnsignedDivisor::div_mod(const LargeUnsignedInteger& lhs) const {
+	LargeUnsignedInteger quot;	// quotient
+	LargeUnsignedInteger rem;	// remainder
+
+	div_mod(lhs, quot, rem);
+
+	// Return quotient & remainder as pair
+	return std::make_pair(std::move(quot), std::move(rem));
+}
+
+
+// Set q and r to the quotient & remainder of a LargeUnsignedInteger object divided by this
+// Reuses the arrays of q and r, so repeated calls don't allocate below BARRETT_THRESHOLD and DIV_DC_THRESHOLD
+// once they have grown. q and r must be different objects, but either may be lhs
+void LargeUnsignedDivisor::div_mod(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& q, LargeUnsignedInteger& r) const {
+	unsigned int nn = lhs.num_segments;		// words of dividend
+	unsigned int dn = value.num_segments;	// words of divisor
+
+	// Single-word divisor. One 2-by-1 reciprocal division per word
+	if(dn == 1) {
+		q.resize(nn);
+		r = LargeUnsignedInteger::div_1_preinv(q.arr, lhs.arr, nn, norm.arr[0], shift, inv);
+		q.trim();
+	}
+
+	// Divisor is larger, so quotient is 0 and remainder is dividend
+	else if(lhs < value) {
+		if(&r != &lhs)
+			r = lhs;
+		q = 0;
+	}
+
+	// Barrett reduction, for dividends within the precision of the Barrett constant
+	else if(recip_bits  &&  lhs.bit_length() <= recip_bits) {
+		quot_rem qr = lhs.div_mod(value, recip, recip_bits);
+		q = std::move(qr.first);
+		r = std::move(qr.second);
+	}
+
+	// Long division with the normalized divisor, with the dividend normalized in r
+	else {
+		normalize(lhs, r);
+		q.resize(nn+1 - dn);
+		divide(q.arr, r);
+		q.trim();
+	}
+}
+
+
+// Return the quotient of a LargeUnsignedInteger object divided by this
+LargeUnsignedInteger LargeUnsignedDivisor::quot(const LargeUnsignedInteger& lhs) const {
+	return div_mod(lhs).first;
+}
+
+
+// Return the remainder of a LargeUnsignedInteger object divided by this
+LargeUnsignedInteger LargeUnsignedDivisor::rem(const LargeUnsignedInteger& lhs) const {
+	LargeUnsignedInteger r;
+	rem(lhs, r);
+	return r;
+}
+
+
+// Set r to the remainder of a LargeUnsignedInteger object divided by this
+// Reuses the array of r, and the divisor's scratch for the quotient, so repeated calls don't allocate below
+// BARRETT_THRESHOLD and DIV_DC_THRESHOLD once they have grown. r may be lhs
+void LargeUnsignedDivisor::rem(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& r) const {
+	unsigned int nn = lhs.num_segments;		// words of dividend
+	unsigned int dn = value.num_segments;	// words of divisor
+
+	// Single-word divisor needs no quotient
+	if(dn == 1)
+		r = LargeUnsignedInteger::mod_1_preinv(lhs.arr, nn, norm.arr[0], shift, inv);
+
+	// Divisor is larger, so remainder is dividend
+	else if(lhs < value) {
+		if(&r != &lhs)
+			r = lhs;
+	}
+
+	// Barrett reduction, for dividends within the precision of the Barrett constant
+	else if(recip_bits  &&  lhs.bit_length() <= recip_bits)
+		r = lhs.div_mod(value, recip, recip_bits).second;
+
+	// Long division with the normalized divisor, with the dividend normalized in r
+	else {
+		normalize(lhs, r);
+		scratch.reserve(nn+1 - dn);
+		divide(scratch.arr, r);
+	}
+}
+
+
+// Set r to lhs shifted left by the normalization shift, in nn+1 words for the division. r may be lhs
+void LargeUnsignedDivisor::normalize(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& r) const {
+	unsigned int nn = lhs.num_segments;
+
+	// Grows r, and lhs with it if they are the same object
+	r.resize(nn+1);
+
+	if(shift)
+		r.arr[nn] = LargeUnsignedInteger::lshift(r.arr, lhs.arr, nn, shift);
+	else {
+		if(&r != &lhs)
+			for(unsigned int i = 0;  i < nn;  ++i)
+				r.arr[i] = lhs.arr[i];
+		r.arr[nn] = 0;
+	}
+}
+
+
+// Divide r, normalized by normalize(), by the normalized divisor. Writes the quotient words to qp, and leaves
+// the denormalized remainder in r
+void LargeUnsignedDivisor::divide(ull_t* qp, LargeUnsignedInteger& r) const {
+	unsigned int nn = r.num_segments;		// words of normalized dividend
+	unsigned int dn = value.num_segments;	// words of divisor
+
+	if(dn < LargeUnsignedInteger::DIV_DC_THRESHOLD)
+		LargeUnsignedInteger::div_basecase(qp, r.arr, nn, norm.arr, dn, inv);
+	else
+		LargeUnsignedInteger::div_dc(qp, r.arr, nn, norm.arr, dn, inv);
+
+	// Denormalize remainder
+	if(shift)
+		LargeUnsignedInteger::rshift(r.arr, r.arr, dn, shift);
+	r.resize(dn);
+	r.trim();
+}
@@ -0,0 +1,47 @@
+
+#ifndef LARGEUNSIGNEDDIVISOR_H_
+#define LARGEUNSIGNEDDIVISOR_H_
+
+
+#include "LargeUnsignedInteger.h"
+
+
+
+// Divisor with its normalization and reciprocals precomputed, for repeated division by the same value
+// rem() into an existing object uses the divisor's scratch, so a divisor must not be shared between threads; copy it
+class LargeUnsignedDivisor {
+private:
+	LargeUnsignedInteger value;		// divisor
+	LargeUnsignedInteger norm;		// divisor left-shifted so that its top bit is set
+	unsigned int shift;				// normalization shift, in bits
+	ull_t inv;						// reciprocal of the top word of norm
+	LargeUnsignedInteger recip;		// Barrett constant floor(2^recip_bits / value)
+	unsigned int recip_bits;		// precision of recip. 0 if not computed
+	mutable LargeUnsignedInteger scratch;	// quotient words discarded by rem(), grown as needed
+
+	void init();
+	void normalize(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& r) const;
+	void divide(ull_t* qp, LargeUnsignedInteger& r) const;
+
+
+public:
+	// Divisor words at which the Barrett constant is computed and used. Set to UINT_MAX to disable
+	static unsigned int BARRETT_THRESHOLD;
+
+	LargeUnsignedDivisor(const LargeUnsignedInteger& num);
+	LargeUnsignedDivisor(ull_t num);
+
+	const LargeUnsignedInteger& get_value() const;
+	unsigned int get_size() const;
+
+	quot_rem div_mod(const LargeUnsignedInteger& lhs) const;
+	LargeUnsignedInteger quot(const LargeUnsignedInteger& lhs) const;
+	LargeUnsignedInteger rem(const LargeUnsignedInteger& lhs) const;
+
+	// Results into existing objects, reusing their arrays
+	void div_mod(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& q, LargeUnsignedInteger& r) const;
+	void rem(const LargeUnsignedInteger& lhs, LargeUnsignedInteger& r) const;
+};
+
+
+#endif /* LARGEUNSIGNEDDIVISOR_H_ */
@@ -1,1525 +1,4040 @@
-
-#include "LargeUnsignedInteger.h"
-#include <exception>
-#include <utility>
-#include <ostream>
-#include <string>
-#include <iomanip>
-
-
-// Static constants
-const ull_t LargeUnsignedInteger::NUM_ONE_TENTH_INIT = 0xCCCC'CCCC'CCCC'CCCCull;
-const ull_t LargeUnsignedInteger::NUM_ONE_TENTH = 0xCCCC'CCCDull;
-//const ull_t LargeUnsignedInteger::NUM_ONE_TENTH = 3'435'973'837ull;
-const ull_t LargeUnsignedInteger::DEN_POW_ONE_TENTH = 35ull;
-const unsigned int LargeUnsignedInteger::UINT_BITS = sizeof(unsigned int) * 8;
-const unsigned int LargeUnsignedInteger::ULL_BITS = sizeof(ull_t) * 8;
-
-
-// Default Constructor
-LargeUnsignedInteger::LargeUnsignedInteger() :
-		num_segments	{1},
-		arr				{new ull_t[1]}
-{
-	refresh_arr_half();
-
-	arr[0] = 0;
-}
-
-
-// Scalar Initializing Constructor
-LargeUnsignedInteger::LargeUnsignedInteger(ull_t num) :
-		num_segments	{1},
-		arr				{new ull_t[1]}
-{
-	refresh_arr_half();
-
-	arr[0] = num;
-}
-
-
-// Array Initializing Constructor
-LargeUnsignedInteger::LargeUnsignedInteger(unsigned int len, const ull_t* num) :
-		num_segments	{len},
-		arr				{new ull_t[len]}
-{
-	refresh_arr_half();
-
-	for(;  len > 0;  --len)
-		arr[len-1] = num[len-1];
-
-	trim();
-}
-
-
-// String Initializing Constructor
-LargeUnsignedInteger::LargeUnsignedInteger(const std::string& str) :
-		LargeUnsignedInteger()	// call default constructor
-{
-	// Parse string
-	set(str);
-}
-
-
-// Copy Constructor
-LargeUnsignedInteger::LargeUnsignedInteger(const LargeUnsignedInteger& rhs) :
-		num_segments	{rhs.num_segments},
-		arr				{new ull_t[rhs.num_segments]}
-{
-	refresh_arr_half();
-
-	// Copy rhs array to this array
-	for(unsigned int i = 0;  i < num_segments;  ++i)
-		this->arr[i] = rhs.arr[i];
-}
-
-
-// Move Constructor
-LargeUnsignedInteger::LargeUnsignedInteger(LargeUnsignedInteger&& rhs) :
-		num_segments	{rhs.num_segments},
-		arr				{rhs.arr}
-{
-	refresh_arr_half();
-
-	// Nullify rhs
-	rhs.num_segments = 0;
-	rhs.arr = nullptr;
-	rhs.refresh_arr_half();
-}
-
-
-// Destructor
-LargeUnsignedInteger::~LargeUnsignedInteger() {
-	delete[] arr;
-}
-
-
-// Return array size
-unsigned int LargeUnsignedInteger::get_size() const {
-	return num_segments;
-}
-
-
-// Check if value is zero
-bool LargeUnsignedInteger::is_zero() const {
-	return num_segments == 1 && arr[0] == 0;
-}
-
-
-// Set array to zero
-void LargeUnsignedInteger::reset() {
-	// Resize array
-	if(num_segments > 1) {
-		assign_arr(new ull_t[1]);
-		num_segments = 1;
-	}
-
-	// Set value to zero
-	arr[0] = 0;
-}
-
-
-// Set array to value
-void LargeUnsignedInteger::set(ull_t num) {
-	// Resize array
-	if(num_segments > 1) {
-		assign_arr(new ull_t[1]);
-		num_segments = 1;
-	}
-
-	// Set value
-	arr[0] = num;
-}
-
-
-// Set array to array value
-void LargeUnsignedInteger::set(unsigned int len, const ull_t* nums) {
-	// Resize array
-	if(num_segments != len) {
-		assign_arr(new ull_t[len]);
-		num_segments = len;
-	}
-
-	// Set values
-	for(;  len > 0;  --len)
-		arr[len-1] = nums[len-1];
-
-	// Trim object
-	trim();
-}
-
-
-// Set array to string value
-void LargeUnsignedInteger::set(const std::string& str) {
-	// Reset array
-	reset();
-
-	// Throw error for empty string
-	if(str.empty())
-		throw std::invalid_argument("String argument is empty.");
-
-	// Special case for input 0
-	if(str.length() == 1  &&  str[0] == '0')
-		return;
-
-	std::string::const_iterator itr = str.cbegin();
-	std::string::const_iterator itr_end = str.cend();
-
-	// Check for integer literal prefix
-	if(*itr == '0') {
-		// Number is hexadecimal
-		if(*(itr+1) == 'X' || *(itr+1) == 'x') {
-			itr += 2;
-			construct_string_hex(itr, itr_end);
-		}
-
-		// Number is binary
-		else if(*(itr+1) == 'B' || *(itr+1) == 'b') {
-			// Increment past prefix
-			itr += 2;
-			construct_string_bin(itr, itr_end);
-		}
-
-		// Number is octal
-		else {
-			// Increment past prefix
-			++itr;
-			construct_string_oct(itr, itr_end);
-		}
-	}
-
-	// Number is decimal
-	else {
-		construct_string_dec(itr, itr_end);
-	}
-
-	trim();
-}
-
-
-// Return low word from arr
-ull_t LargeUnsignedInteger::get_low_word() const {
-	return arr[0];
-}
-
-
-// Return the sum of two LargeUnsignedInteger objects as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator+(const LargeUnsignedInteger& rhs) const {
-	unsigned int min_segments;
-	const LargeUnsignedInteger* max_op;
-
-	// Determine which operand is smaller / larger
-	if(this->num_segments < rhs.num_segments) {
-		min_segments = this->num_segments;
-		max_op = &rhs;
-	} else {
-		min_segments = rhs.num_segments;
-		max_op = this;
-	}
-
-	// Initialize return object with larger number of segments
-	LargeUnsignedInteger rtn{};
-	rtn.resize(max_op->num_segments);
-
-	// Half adder sum. Needed to check for carry out
-	ull_t half_sum;
-
-	// Adder carry bit
-	ull_t carry = 0;
-
-	unsigned int i = 0;
-
-	// Full Adder
-	for(;  i < min_segments;  ++i) {
-		half_sum = this->arr[i] + rhs.arr[i];
-		rtn.arr[i] = half_sum + carry;
-		carry = (this->arr[i] > ULL_MAX - rhs.arr[i])  ||  (half_sum > ULL_MAX - carry);
-	}
-
-	// Half Adder to propagate carry
-	for(;  i < max_op->num_segments;  ++i) {
-		rtn.arr[i] = max_op->arr[i] + carry;
-		carry = max_op->arr[i] > ULL_MAX - carry;
-	}
-
-	// Add additional word for carry out
-	if(carry) {
-		rtn.resize(rtn.num_segments+1);
-		rtn.arr[rtn.num_segments-1] = 1;
-	}
-
-	return rtn;
-}
-
-
-// Return the sum of a LargeUnsignedInteger object with a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator+(const ull_t& rhs) const {
-	// Initialize return object
-	LargeUnsignedInteger rtn{};
-	rtn.resize(this->num_segments);
-
-	// Adder carry bit
-	ull_t carry;
-
-	// Add rhs
-	rtn.arr[0] = this->arr[0] + rhs;
-	carry = this->arr[0] > ULL_MAX - rhs;
-
-	// Half Adder to propagate carry
-	for(unsigned int i = 1;  i < this->num_segments;  ++i) {
-		rtn.arr[i] = this->arr[i] + carry;
-		carry = this->arr[i] > ULL_MAX - carry;
-	}
-
-	// Add additional word for carry out
-	if(carry) {
-		rtn.resize(rtn.num_segments+1);
-		rtn.arr[rtn.num_segments-1] = 1;
-	}
-
-	return rtn;
-}
-
-
-// Return the difference of two LargeUnsignedInteger objects as a new object
-// Behavior is undefined if LHS < RHS
-LargeUnsignedInteger LargeUnsignedInteger::operator-(const LargeUnsignedInteger& rhs) const {
-	unsigned int min_segments;
-	const LargeUnsignedInteger* max_op;
-
-	// Determine which operand is smaller / larger
-	if(this->num_segments < rhs.num_segments) {
-		min_segments = this->num_segments;
-		max_op = &rhs;
-	} else {
-		min_segments = rhs.num_segments;
-		max_op = this;
-	}
-
-	// Initialize return object with larger number of segments
-	LargeUnsignedInteger rtn{};
-	rtn.resize(max_op->num_segments);
-
-	// Half subtracter difference. Needed to check for borrow in
-	ull_t half_diff;
-
-	// Subtracter borrow bit
-	ull_t borrow = 0;
-
-	unsigned int i = 0;
-
-	// Full Subtracter
-	for(;  i < min_segments;  ++i) {
-		half_diff = this->arr[i] - rhs.arr[i];
-		rtn.arr[i] = half_diff - borrow;
-		borrow = (this->arr[i] < rhs.arr[i]) || (half_diff < borrow);
-	}
-
-	// This is larger array. Half Subtracter to propagate borrow
-	if(this == max_op) {
-		for(;  i < max_op->num_segments;  ++i) {
-			rtn.arr[i] = this->arr[i] - borrow;
-			borrow = this->arr[i] < borrow;
-		}
-	}
-	// This is smaller array. Full Subtracter for remaining RHS segments
-	else {
-		for(;  i < max_op->num_segments;  ++i) {
-			half_diff = -rhs.arr[i];
-			rtn.arr[i] = half_diff - borrow;
-			borrow = (0 < rhs.arr[i]) || (half_diff < borrow);
-		}
-	}
-
-	// Trim return object
-	rtn.trim();
-
-	return rtn;
-}
-
-// Return the difference of a LargeUnsignedInteger object with a ull as a new object
-// Behavior is undefined if LHS < RHS
-LargeUnsignedInteger LargeUnsignedInteger::operator-(const ull_t& rhs) const {
-	// Initialize return object
-	LargeUnsignedInteger rtn{};
-	rtn.resize(this->num_segments);
-
-	// Subtracter borrow bits
-	ull_t borrow;
-
-	// Subtract RHS operand
-	rtn.arr[0] = this->arr[0] - rhs;
-	borrow = this->arr[0] < rhs;
-
-	// Half Subtracter to propagate borrow
-	for(unsigned int i = 1;  i < this->num_segments;  ++i) {
-		rtn.arr[i] = this->arr[i] - borrow;
-		borrow = this->arr[i] < borrow;
-	}
-
-	// Trim return object
-	rtn.trim();
-
-	return rtn;
-}
-
-
-// Return the product of two LargeUnsignedInteger objects as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator*(const LargeUnsignedInteger& rhs) const {
-	// Initialize return object
-	LargeUnsignedInteger rtn;
-	rtn.resize(this->num_segments + rhs.num_segments);
-
-	// Temporary object to accumulate full-word product
-	LargeUnsignedInteger prod;
-	prod.resize(this->num_segments + rhs.num_segments);
-
-	ull_t prod_ull;	// temporary variable to calculate full-word product
-	unsigned int k;	// product index
-
-	// Iterate through half-words of this
-	for(unsigned int ih = 0;  ih < this->num_segments * 2;  ++ih) {
-
-		// Iterate through half-words of rhs
-		for(unsigned int jh = 0;  jh < rhs.num_segments * 2;  ++jh) {
-			// Multiply half-words
-			prod_ull = static_cast<ull_t>(this->arr_half[ih]) * rhs.arr_half[jh];
-
-			// Skip if result is 0
-			if(prod_ull != 0) {
-				// Product index
-				k = ih + jh;
-
-				// Set product object
-				prod.arr_half[k] = static_cast<unsigned int>(prod_ull);
-				prod.arr_half[k+1] = static_cast<unsigned int>(prod_ull >> UINT_BITS);
-
-				// Accumulate product into return object
-				rtn += prod;
-
-				// Reset product object
-				prod.arr_half[k] = 0;
-				prod.arr_half[k+1] = 0;
-			}
-		}
-	}
-
-	// Trim return object
-	rtn.trim();
-
-	return rtn;
-}
-
-
-// Return the product of a LargeUnsignedInteger object with a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator*(const ull_t& rhs) const {
-	// Initialize return object
-	LargeUnsignedInteger rtn;
-	rtn.resize(this->num_segments + 1);
-
-	// Temporary object to accumulate full-word product
-	LargeUnsignedInteger prod;
-	prod.resize(this->num_segments + 1);
-
-	ull_t prod_ull;		// temporary variable to calculate full-word product
-	unsigned int carry;	// carry bit
-	bool prod_nonzero;	// flag that product is non-zero
-
-	// Iterate through half-words of this
-	for(unsigned int ih = 0;  ih < this->num_segments * 2;  ++ih) {
-		// Reset flag
-		prod_nonzero = false;
-
-		// Multiply half-words using rhs lower-half
-		prod_ull = static_cast<ull_t>(this->arr_half[ih]) * static_cast<unsigned int>(rhs);
-
-		// Skip if result is 0
-		if(prod_ull != 0) {
-			// Set flag
-			prod_nonzero = true;
-
-			// Set product object
-			prod.arr_half[ih] = static_cast<unsigned int>(prod_ull);
-			prod.arr_half[ih+1] = static_cast<unsigned int>(prod_ull >> UINT_BITS);
-		}
-
-		// Multiply half-words using rhs upper-half
-		prod_ull = static_cast<ull_t>(this->arr_half[ih]) * static_cast<unsigned int>(rhs >> UINT_BITS);
-
-		// Skip if result is 0
-		if(prod_ull != 0) {
-			// Set flag
-			prod_nonzero = true;
-
-			// Accumulate product object
-			carry = prod.arr_half[ih+1] > UINT_MAX - static_cast<unsigned int>(prod_ull);
-			prod.arr_half[ih+1] += static_cast<unsigned int>(prod_ull);
-			prod.arr_half[ih+2] = static_cast<unsigned int>(prod_ull >> UINT_BITS) + carry;
-		}
-
-		// Skip if product is zero
-		if(prod_nonzero) {
-			// Accumulate product into return object
-			rtn += prod;
-
-			// Reset product object
-			prod.arr_half[ih] = 0;
-			prod.arr_half[ih+1] = 0;
-			prod.arr_half[ih+2] = 0;
-		}
-	}
-
-	// Trim return object
-	rtn.trim();
-
-	return rtn;
-}
-
-
-quot_rem LargeUnsignedInteger::div_mod(const LargeUnsignedInteger& rhs) const {
-	LargeUnsignedInteger quot;	// quotient
-	LargeUnsignedInteger rem;	// remainder
-
-	// Divisor is larger, so quotient is 0 and remainder is dividend
-	if(this->num_segments < rhs.num_segments)
-		rem = *this;
-
-	// Perform division
-	else {
-		quot.resize(this->num_segments);
-
-		// Reverse-iterate through words
-		for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i)
-			// Reverse-iterate through bits
-			for(unsigned int j = ULL_BITS-1;  j < ULL_BITS;  --j) {
-				// Append next-highest bit to remainder
-				rem <<= 1ull;
-				rem.arr[0] |= this->arr[i] >> j & 1;
-
-				// Subtract divisor
-				if(rem >= rhs) {
-					// Track division in quotient
-					quot.arr[i] |= 1ull << j;
-
-					// Update remainder
-					rem -= rhs;
-				}
-			}
-
-		// Trim quotient
-		quot.trim();
-	}
-
-	// Return quotient & remainder as pair
-	return std::make_pair(quot, rem);
-}
-
-
-quot_rem LargeUnsignedInteger::div_mod(const ull_t& rhs) const {
-	LargeUnsignedInteger quot;	// quotient
-	LargeUnsignedInteger rem;	// remainder
-	ull_t rem_ull = 0ull;		// ull_t remainder
-	bool rem_ovf;				// flag to track remainder overflow
-
-	// Resize quotient
-	quot.resize(this->num_segments);
-
-	// Reverse-iterate through words
-	for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i)
-		// Reverse-iterate through bits
-		for(unsigned int j = ULL_BITS-1;  j < ULL_BITS;  --j) {
-			// Track overflow
-			rem_ovf = rem_ull & (1ull << 63);
-
-			// Append next-highest bit to remainder
-			rem_ull <<= 1;
-			rem_ull |= this->arr[i] >> j & 1;
-
-			// Subtract divisor
-			if(rem_ull >= rhs || rem_ovf) {
-				// Track division in quotient
-				quot.arr[i] |= 1ull << j;
-
-				// Update remainder
-				rem_ull -= rhs;
-			}
-		}
-
-	// Trim quotient
-	quot.trim();
-
-	// Copy ull_t remainder to object
-	rem.arr[0] = rem_ull;
-
-	// Return quotient & remainder as pair
-	return std::make_pair(quot, rem);
-}
-
-
-// Return the quotient of one LargeUnsignedInteger object divided by another as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator/(const LargeUnsignedInteger& rhs) const {
-	quot_rem res = this->div_mod(rhs);
-	return res.first;
-}
-
-
-// Return the quotient of a LargeUnsignedInteger object divided by a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator/(const ull_t& rhs) const {
-	quot_rem res = this->div_mod(rhs);
-	return res.first;
-}
-
-
-// Return the remainder of one LargeUnsignedInteger object divided by another as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator%(const LargeUnsignedInteger& rhs) const {
-	quot_rem res = this->div_mod(rhs);
-	return res.second;
-}
-
-
-// Return the remainder of a LargeUnsignedInteger object divided by a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator%(const ull_t& rhs) const {
-	quot_rem res = this->div_mod(rhs);
-	return res.second;
-}
-
-
-// Return the left-shift of a LargeUnsignedInteger object by a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator<<(const ull_t& rhs) const {
-	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
-	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
-	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
-
-	// Construct return object
-	LargeUnsignedInteger rtn;
-
-	// Resize object to append extra bit-shift cycles and potential overflow
-	rtn.resize(this->num_segments + shift_cycles + 1);
-
-	// Reverse-iterate through words
-	for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i) {
-		// Catch 64-bit shift error
-		if(shift_bits > 0)
-			// Append high-portion of word
-			rtn.arr[i+1+shift_cycles] |= this->arr[i] >> shift_bits_rev;
-
-		// Shift low-portion of word
-		rtn.arr[i+shift_cycles] = this->arr[i] << shift_bits;
-	}
-
-	// Trim return object
-	rtn.trim();
-
-	return rtn;
-}
-
-
-// Return the right-shift of a LargeUnsignedInteger object by a ull as a new object
-LargeUnsignedInteger LargeUnsignedInteger::operator>>(const ull_t& rhs) const {
-	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
-	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
-	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
-
-	// Construct return object
-	LargeUnsignedInteger rtn;
-
-	// Skip if all words are shifted out
-	if(shift_cycles < this->num_segments) {
-		// Resize object to remove cleared bit-shift cycles
-		rtn.resize(this->num_segments - shift_cycles);
-
-		// Iterate through words
-		for(unsigned int i = shift_cycles;  i < this->num_segments-1;  ++i) {
-			// Shift high-portion of low-word
-			rtn.arr[i-shift_cycles] = this->arr[i] >> shift_bits;
-
-			// Catch 64-bit shift error
-			if(shift_bits > 0)
-				// Append low-portion of high-word
-				rtn.arr[i-shift_cycles] |= this->arr[i+1] << shift_bits_rev;
-		}
-
-		// Shift low-portion of highest word
-		rtn.arr[rtn.num_segments-1] = this->arr[this->num_segments-1] >> shift_bits;
-
-		// Trim object
-		rtn.trim();
-	}
-
-	return rtn;
-}
-
-
-// Check if a LargeUnsignedInteger object is less than another object
-bool LargeUnsignedInteger::operator<(const LargeUnsignedInteger& rhs) const {
-	// Compare array sizes
-	if(this->num_segments < rhs.num_segments)
-		return true;
-	if(this->num_segments > rhs.num_segments)
-		return false;
-
-	// Reverse-iterate through array words
-	for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i) {
-		if(this->arr[i] < rhs.arr[i])
-			return true;
-		if(this->arr[i] > rhs.arr[i])
-			return false;
-	}
-
-	// Numbers are equal
-	return false;
-}
-
-
-// Check if a LargeUnsignedInteger object is less than a ull
-bool LargeUnsignedInteger::operator<(const ull_t& rhs) const {
-	// Check if array is multiple words
-	if(this->num_segments > 1)
-		return false;
-
-	// Compare directly
-	return this->arr[0] < rhs;
-}
-
-
-// Check if a LargeUnsignedInteger object is greater than another object
-bool LargeUnsignedInteger::operator>(const LargeUnsignedInteger& rhs) const {
-	return rhs < *this;
-}
-
-
-// Check if a LargeUnsignedInteger object is greater than a ull
-bool LargeUnsignedInteger::operator>(const ull_t& rhs) const {
-	// Check if array is multiple words
-	if(this->num_segments > 1)
-		return true;
-
-	// Compare directly
-	return this->arr[0] > rhs;
-}
-
-
-// Check if a LargeUnsignedInteger object is less than or equal to another object
-bool LargeUnsignedInteger::operator<=(const LargeUnsignedInteger& rhs) const {
-	return !(rhs < *this);
-}
-
-
-// Check if a LargeUnsignedInteger object is less than or equal to a ull
-bool LargeUnsignedInteger::operator<=(const ull_t& rhs) const {
-	return !(*this > rhs);
-}
-
-
-// Check if a LargeUnsignedInteger object is greater than or equal to another object
-bool LargeUnsignedInteger::operator>=(const LargeUnsignedInteger& rhs) const {
-	return !(*this < rhs);
-}
-
-
-// Check if a LargeUnsignedInteger object is greater than or equal to a ull
-bool LargeUnsignedInteger::operator>=(const ull_t& rhs) const {
-	return !(*this < rhs);
-}
-
-
-// Check if a LargeUnsignedInteger object is equal to another object
-bool LargeUnsignedInteger::operator==(const LargeUnsignedInteger& rhs) const {
-	// Compare array sizes
-	if(this->num_segments != rhs.num_segments)
-		return false;
-
-	// Iterate through array words
-	for(unsigned int i = 0;  i < this->num_segments;  ++i) {
-		if(this->arr[i] != rhs.arr[i])
-			return false;
-	}
-
-	// Numbers are equal
-	return true;
-}
-
-
-// Check if a LargeUnsignedInteger object is equal to a ull
-bool LargeUnsignedInteger::operator==(const ull_t& rhs) const {
-	// Check if array is multiple words
-	if(this->num_segments > 1)
-		return false;
-
-	// Compare directly
-	return this->arr[0] == rhs;
-}
-
-
-// Check if a LargeUnsignedInteger object is not equal to another object
-bool LargeUnsignedInteger::operator!=(const LargeUnsignedInteger& rhs) const {
-	return !(*this == rhs);
-}
-
-
-// Check if a LargeUnsignedInteger object is not equal to a ull
-bool LargeUnsignedInteger::operator!=(const ull_t& rhs) const {
-	return !(*this == rhs);
-}
-
-
-// Accumulate the sum of two LargeUnsignedInteger objects into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator+=(const LargeUnsignedInteger& rhs) {
-	// Get min segments
-	unsigned int min_segments = MIN(this->num_segments, rhs.num_segments);
-
-	// Resize this
-	this->resize(MAX(this->num_segments, rhs.num_segments));
-
-	// Half adder sum. Needed to check for carry out
-	ull_t half_sum;
-
-	// Adder carry bit
-	ull_t carry = 0;
-
-	unsigned int i = 0;
-
-	// Full Adder through min_segments
-	for(;  i < min_segments;  ++i) {
-		half_sum = rhs.arr[i] + carry;
-		carry = (this->arr[i] > ULL_MAX - half_sum)  ||  (rhs.arr[i] > ULL_MAX - carry);
-		this->arr[i] += half_sum;
-	}
-
-	// This is smaller array. Full Adder for remaining RHS segments
-	if(rhs.num_segments > min_segments) {
-		// Process remaining segments
-		for(;  i < rhs.num_segments;  ++i) {
-			this->arr[i] += rhs.arr[i] + carry;
-			carry = rhs.arr[i] > ULL_MAX - carry;
-		}
-	}
-	// This is larger array. Half Adder to propagate carry
-	else {
-		// Process remaining segments
-		for(;  i < this->num_segments && carry;  ++i) {
-			half_sum = carry;
-			carry = this->arr[i] > ULL_MAX - half_sum;
-			this->arr[i] += half_sum;
-		}
-	}
-
-	// Add additional word for carry out
-	if(carry) {
-		this->resize(this->num_segments+1);
-		this->arr[this->num_segments-1] = 1;
-	}
-
-	return *this;
-}
-
-
-// Accumulate the sum of a LargeUnsignedInteger object with a ull into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator+=(const ull_t& rhs) {
-	// Half adder sum. Needed to check for carry out
-	ull_t half_sum;
-
-	// Adder carry bit
-	ull_t carry;
-
-	// Add RHS operand
-	carry = this->arr[0] > ULL_MAX - rhs;
-	this->arr[0] += rhs;
-
-	// Half Adder to propagate carry
-	for(unsigned int i = 1;  i < this->num_segments && carry;  ++i) {
-		half_sum = carry;
-		carry = this->arr[i] > ULL_MAX - carry;
-		this->arr[i] += half_sum;
-	}
-
-	// If LHS operand is dynamic and carry out, resize to propagate carry
-	if(carry) {
-		this->resize(this->num_segments+1);
-		this->arr[this->num_segments-1] = 1;
-	}
-
-	return *this;
-}
-
-
-// Accumulate the difference of two LargeUnsignedInteger objects into the LHS
-// Behavior is undefined if LHS < RHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator-=(const LargeUnsignedInteger& rhs) {
-	// Get smaller number of segments for initial accumulation
-	unsigned int min_segments = MIN(this->num_segments, rhs.num_segments);
-
-	// Resize this
-	this->resize(MAX(this->num_segments, rhs.num_segments));
-
-	// Half subtracter sum. Needed to check for borrow in
-	ull_t half_sum;
-
-	// Subtracter borrow bits
-	ull_t borrow = 0;
-
-	unsigned int i = 0;
-
-	// Full Subtracter
-	for(;  i < min_segments;  ++i) {
-		half_sum = rhs.arr[i] + borrow;
-		borrow = (rhs.arr[i] > ULL_MAX - borrow) || (this->arr[i] < half_sum);
-		this->arr[i] -= half_sum;
-	}
-
-	// This is smaller array. Full Subtracter for remaining RHS segments.
-	if(rhs.num_segments > min_segments) {
-		for(;  i < rhs.num_segments;  ++i) {
-			half_sum = rhs.arr[i] + borrow;
-			borrow = (rhs.arr[i] > ULL_MAX - borrow) || (this->arr[i] < half_sum);
-			this->arr[i] -= half_sum;
-		}
-	}
-	// This is larger array. Full Subtracter to propagate borrow
-	else {
-		for(;  i < this->num_segments && borrow;  ++i) {
-			half_sum = borrow;
-			borrow = this->arr[i] < borrow;
-			this->arr[i] -= half_sum;
-		}
-	}
-
-	// Trim this
-	this->trim();
-
-	return *this;
-}
-
-
-// Accumulate the difference of a LargeUnsignedInteger object with a ull into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator-=(const ull_t& rhs) {
-	// Half subtracter sum. Needed to check for borrow in
-	ull_t half_sum;
-
-	// Subtracter borrow bit
-	ull_t borrow;
-
-	// Subtract RHS operand
-	borrow = this->arr[0] < rhs;
-	this->arr[0] -= rhs;
-
-	// Full Subtracter to propagate borrow
-	for(unsigned int i = 1;  i < this->num_segments && borrow;  ++i) {
-		half_sum = borrow;
-		borrow = this->arr[i] < borrow;
-		this->arr[i] -= half_sum;
-	}
-
-	// Trim this
-	this->trim();
-
-	return *this;
-}
-
-
-// Accumulate the product of two LargeUnsignedInteger objects into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator*=(const LargeUnsignedInteger& rhs) {
-	// Resize this
-	this->resize(this->num_segments + rhs.num_segments);
-
-	// Temporary object to accumulate full-word product
-	LargeUnsignedInteger prod;
-	prod.resize(this->num_segments + rhs.num_segments);
-
-	ull_t prod_ull;	// temporary variable to calculate full-word product
-	unsigned int k;	// product index
-
-	// Reverse-iterate through half-words of this
-	for(unsigned int ih = (this->num_segments * 2) - 1;  ih < this->num_segments * 2;  --ih) {
-
-		// Reverse-iterate through half-words of rhs
-		for(unsigned int jh = (rhs.num_segments * 2) - 1;  jh < rhs.num_segments * 2;  --jh) {
-			// Multiply half-words
-			prod_ull = static_cast<ull_t>(this->arr_half[ih]) * rhs.arr_half[jh];
-
-			// Clear half-word multiplicand from this, so that product can be accumulated
-			if(jh == 0)
-				this->arr_half[ih] = 0;
-
-			// Skip if result is 0
-			if(prod_ull != 0) {
-				// Product index
-				k = ih + jh;
-
-				// Set product object
-				prod.arr_half[k] = static_cast<unsigned int>(prod_ull);
-				prod.arr_half[k+1] = static_cast<unsigned int>(prod_ull >> UINT_BITS);
-
-				// Accumulate product into this
-				*this += prod;
-
-				// Reset product object
-				prod.arr_half[k] = 0;
-				prod.arr_half[k+1] = 0;
-			}
-		}
-	}
-
-	// Trim object
-	this->trim();
-
-	return *this;
-}
-
-
-// Accumulate the product of a LargeUnsignedInteger object with a ull into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator*=(const ull_t& rhs) {
-	// Resize this
-	this->resize(this->num_segments + 1);
-
-	// Temporary object to accumulate full-word product
-	LargeUnsignedInteger prod;
-	prod.resize(this->num_segments);
-
-	ull_t prod_ull;		// temporary variable to calculate full-word product
-	unsigned int carry;	// carry bit
-	bool prod_nonzero;	// flag that product is non-zero
-
-	// Reverse-iterate through half-words of this
-	for(unsigned int ih = (this->num_segments * 2) - 3;  ih < this->num_segments * 2;  --ih) {
-		// Reset flag
-		prod_nonzero = false;
-
-		// Multiply half-words using rhs upper-half
-		prod_ull = static_cast<ull_t>(this->arr_half[ih]) * static_cast<unsigned int>(rhs >> UINT_BITS);
-
-		// Skip if result is 0
-		if(prod_ull != 0) {
-			// Set flag
-			prod_nonzero = true;
-
-			// Set product object
-			prod.arr_half[ih+1] = static_cast<unsigned int>(prod_ull);
-			prod.arr_half[ih+2] = static_cast<unsigned int>(prod_ull >> UINT_BITS);
-		}
-
-		// Multiply half-words using rhs lower-half
-		prod_ull = static_cast<ull_t>(this->arr_half[ih]) * static_cast<unsigned int>(rhs);
-
-		// Skip if result is 0
-		if(prod_ull != 0) {
-			// Set flag
-			prod_nonzero = true;
-
-			// Accumulate product object
-			prod.arr_half[ih] = static_cast<unsigned int>(prod_ull);
-
-			carry = prod.arr_half[ih+1] > UINT_MAX - static_cast<unsigned int>(prod_ull >> UINT_BITS);
-			prod.arr_half[ih+1] += static_cast<unsigned int>(prod_ull >> UINT_BITS);
-			prod.arr_half[ih+2] += carry;
-		}
-
-		// Clear half-word multiplicand from this, so that product can be accumulated
-		this->arr_half[ih] = 0;
-
-		// Skip if product is zero
-		if(prod_nonzero) {
-			// Accumulate product in return object
-			*this += prod;
-
-			// Reset product object
-			prod.arr_half[ih] = 0;
-			prod.arr_half[ih+1] = 0;
-			prod.arr_half[ih+2] = 0;
-		}
-	}
-
-	// Trim return object
-	this->trim();
-
-	return *this;
-}
-
-
-// Accumulate the quotient of one LargeUnsignedInteger object divided by another into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator/=(const LargeUnsignedInteger& rhs) {
-	quot_rem res = this->div_mod(rhs);
-	*this = std::move(res.first);
-	return *this;
-}
-
-
-// Accumulate the quotient of one LargeUnsignedInteger object divided by a ull the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator/=(const ull_t& rhs) {
-	quot_rem res = this->div_mod(rhs);
-	*this = std::move(res.first);
-	return *this;
-}
-
-
-// Accumulate the remainder of one LargeUnsignedInteger object divided by another into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator%=(const LargeUnsignedInteger& rhs) {
-	quot_rem res = this->div_mod(rhs);
-	*this = std::move(res.second);
-	return *this;
-}
-
-
-// Accumulate the remainder of one LargeUnsignedInteger object divided by a ull the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator%=(const ull_t& rhs) {
-	quot_rem res = this->div_mod(rhs);
-	*this = std::move(res.second);
-	return *this;
-}
-
-
-// Accumulate the left-shift of a LargeUnsignedInteger object by a ull into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator<<=(const ull_t& rhs) {
-	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
-	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
-	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
-
-	// Resize object to append extra bit-shift cycles and potential overflow
-	this->resize(this->num_segments + shift_cycles + 1);
-
-	// Reverse-iterate through words
-	for(unsigned int i = this->num_segments-2-shift_cycles;  i < this->num_segments;  --i) {
-		// Catch 64-bit shift error
-		if(shift_bits > 0)
-			// Append high-portion of word
-			this->arr[i+1+shift_cycles] |= static_cast<ull_t>(this->arr[i]) >> shift_bits_rev;
-
-		// Shift low-portion of word
-		this->arr[i+shift_cycles] = this->arr[i] << shift_bits;
-	}
-
-	// Clear cycled words
-	for(unsigned int i = 0;  i < shift_cycles;  ++i)
-		this->arr[i] = 0ull;
-
-	// Trim object
-	this->trim();
-
-	return *this;
-}
-
-
-// Accumulate the right-shift of a LargeUnsignedInteger object by a ull into the LHS
-LargeUnsignedInteger& LargeUnsignedInteger::operator>>=(const ull_t& rhs) {
-	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
-	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
-	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
-
-	// Reset this if all words are shifted out
-	if(shift_cycles >= this->num_segments)
-		this->reset();
-
-	// Do right-shift
-	else {
-		// Iterate through words
-		for(unsigned int i = shift_cycles;  i < this->num_segments-1;  ++i) {
-			// Shift high-portion of low-word
-			this->arr[i-shift_cycles] = this->arr[i] >> shift_bits;
-
-			// Catch 64-bit shift error
-			if(shift_bits > 0)
-				// Append low-portion of high-word
-				this->arr[i-shift_cycles] |= this->arr[i+1] << shift_bits_rev;
-		}
-
-		// Shift low-portion of highest word
-		this->arr[this->num_segments-1-shift_cycles] = this->arr[this->num_segments-1] >> shift_bits;
-
-		// Clear cycled words
-		for(unsigned int i = this->num_segments-shift_cycles;  i < this->num_segments;  ++i)
-			this->arr[i] = 0;
-
-		// Trim object
-		this->trim();
-	}
-
-	return *this;
-}
-
-
-// Prefix increment
-LargeUnsignedInteger& LargeUnsignedInteger::operator++() {
-	// Increment words until no more overflow
-	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == 0);  ++i)
-		++this->arr[i];
-
-	// Add additional word for overflow
-	if(this->arr[this->num_segments-1] == 0) {
-		this->resize(this->num_segments+1);
-		this->arr[this->num_segments-1] = 1;
-	}
-
-	return *this;
-}
-
-
-// Prefix decrement
-LargeUnsignedInteger& LargeUnsignedInteger::operator--() {
-	// Decrement words until no more underflow
-	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == ULL_MAX);  ++i)
-		--this->arr[i];
-
-	// Trim this
-	this->trim();
-
-	return *this;
-}
-
-
-// Postfix increment
-LargeUnsignedInteger LargeUnsignedInteger::operator++(int) {
-	// Save copy of this before increment
-	LargeUnsignedInteger this_old = *this;
-
-	// Increment words until no more overflow
-	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == 0);  ++i)
-		this->arr[i]++;
-
-	// Add additional word for overflow
-	if(this->arr[this->num_segments-1] == 0) {
-		this->resize(this->num_segments+1);
-		this->arr[this->num_segments-1] = 1;
-	}
-
-	return this_old;
-}
-
-
-// Postfix decrement
-LargeUnsignedInteger LargeUnsignedInteger::operator--(int) {
-	// Save copy of this before decrement
-	LargeUnsignedInteger this_old = *this;
-
-	// Decrement words until no more underflow
-	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == ULL_MAX);  ++i)
-		this->arr[i]--;
-
-	// Trim this
-	this->trim();
-
-	return this_old;
-}
-
-
-// Copy assignment
-// Copy values of RHS array into this array
-LargeUnsignedInteger& LargeUnsignedInteger::operator=(const LargeUnsignedInteger& rhs) {
-	// Do nothing if self-assignment
-	if(this != &rhs) {
-		// Resize if needed
-		if(this->num_segments != rhs.num_segments) {
-			this->assign_arr(new ull_t[rhs.num_segments]);
-			this->num_segments = rhs.num_segments;
-		}
-
-		// Copy rhs array to this array
-		for(unsigned int i = 0; i < this->num_segments; ++i)
-			this->arr[i] = rhs.arr[i];
-	}
-
-	return *this;
-}
-
-
-// Copy assignment scalar
-// Copy value of RHS into this array
-LargeUnsignedInteger& LargeUnsignedInteger::operator=(const ull_t& rhs) {
-	this->set(rhs);
-	return *this;
-}
-
-
-// Move assignment
-// Move values of RHS array into this array
-LargeUnsignedInteger& LargeUnsignedInteger::operator=(LargeUnsignedInteger&& rhs) {
-	// Do nothing if self-assignment
-	if(this != &rhs) {
-		// Reassign array
-		this->assign_arr(rhs.arr);
-		this->num_segments = rhs.num_segments;
-
-		// Nullify rhs
-		rhs.num_segments = 0;
-		rhs.arr = nullptr;
-		rhs.refresh_arr_half();
-	}
-
-	return *this;
-}
-
-
-// Move assignment scalar
-// Move value of RHS into this array
-LargeUnsignedInteger& LargeUnsignedInteger::operator=(ull_t&& rhs) {
-	this->set(rhs);
-	rhs = 0;
-	return *this;
-}
-
-
-// Return quotient & remainder of object divided by ten
-// Adapted from Hacker's Delight, 2nd Edition, Section 10-8
-unsigned int LargeUnsignedInteger::div_mod_ten(const LargeUnsignedInteger& num, const ull_t& den_pow) {
-	LargeUnsignedInteger temp = *this;	// dividend
-	LargeUnsignedInteger quot_ten;		// quotient * 10
-	unsigned int rem;
-
-	// Compute quotient
-	*this = *this * num >> den_pow;
-
-	// Get remainder
-	quot_ten = *this * 10ull;
-	rem = static_cast<unsigned int>(temp.arr[0] - quot_ten.arr[0]);
-
-	return rem;
-}
-
-
-// Output stream
-std::ostream& operator<<(std::ostream& os, const LargeUnsignedInteger& rhs) {
-	LargeUnsignedInteger temp = rhs;
-	std::string dec_digits;
-
-	// Method using div_mod_ten(). Much slower for large numbers.
-	if(rhs.num_segments <= 5) {
-		unsigned int num_segments_old = rhs.num_segments;	// number of segments before division
-
-		LargeUnsignedInteger num_one_tenth;		// numerator
-		num_one_tenth.resize(rhs.num_segments);
-
-		// Fill numerator segments
-		for(unsigned int i = 0;  i < num_one_tenth.num_segments;  ++i)
-			num_one_tenth.arr[i] = LargeUnsignedInteger::NUM_ONE_TENTH_INIT;
-
-		// Finalize numerator
-		num_one_tenth.arr[0] |= 1ull;
-
-		ull_t den_pow_one_tenth = LargeUnsignedInteger::ULL_BITS * num_segments_old + 3;
-
-		// Iterate through digits
-		while(!temp.is_zero()) {
-			// Divide by 10, and store remainder digit as character
-			dec_digits.push_back(temp.div_mod_ten(num_one_tenth, den_pow_one_tenth) + 0x30);
-
-			if(temp.num_segments < num_segments_old) {
-				--num_segments_old;
-				num_one_tenth.resize(num_segments_old);
-				den_pow_one_tenth -= LargeUnsignedInteger::ULL_BITS;
-			}
-		}
-	}
-
-	// Method using standard division
-	else {
-		LargeUnsignedInteger digit;
-
-		// Iterate through digits
-		while(!temp.is_zero()) {
-			digit = temp % 10ull;
-			dec_digits.push_back(digit.arr[0] + 0x30);
-			temp /= 10ull;
-		}
-	}
-
-	// Reverse-iterate through digits to output in correct order
-	for(std::string::const_reverse_iterator itr = dec_digits.crbegin();  itr != dec_digits.crend();  ++itr)
-		os << *itr;
-
-	return os;
-}
-
-
-// Print object debugging info
-void LargeUnsignedInteger::print_debug(const std::string name) const {
-	std::cout << "LargeUnsignedInteger:   " << name << "\n";
-
-	std::cout << "Object Address:         " << this << "\n";
-
-	std::cout << "Array Address:          " << arr << "\n";
-
-	std::cout << "Array UINT Address:     " << arr_half << "\n";
-
-	std::cout << "Array Data (reversed):  [";
-	std::cout << std::hex;
-	for(unsigned int i = num_segments-1; i < num_segments; --i) {
-		std::cout << "0x";
-		std::cout << std::setw(16) << std::setfill('0');
-		std::cout << arr[i];
-		if(i > 0)
-			std::cout << ", ";
-	}
-	std::cout << "]\n";
-	std::cout << std::dec;
-
-	std::cout << "num_segments:           " << num_segments << "\n";
-
-	std::cout << std::endl;
-}
-
-
-bool LargeUnsignedInteger::is_separating_char(char c) {
-	return c == '\'' || c == ' ' || c == ',' || c == '.';
-}
-
-
-// Binary string constructor
-void LargeUnsignedInteger::construct_string_bin(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
-	char d;
-
-	// Iterate through characters
-	for(;  itr != itr_end;  ++itr) {
-		// Extract character
-		d = *itr;
-
-		// Skip separating characters
-		if(!is_separating_char(d)) {
-			// Convert to digit
-			d -= 0x30;
-
-			// Throw error if character is non-octal
-			if(d > 1)
-				throw std::invalid_argument("Binary string argument contains invalid non-binary characters.");
-
-			// Append digit
-			*this <<= 1ull;
-			arr[0] |= static_cast<ull_t>(d);
-		}
-	}
-}
-
-
-// Octal string constructor
-void LargeUnsignedInteger::construct_string_oct(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
-	char d;
-
-	// Iterate through characters
-	for(;  itr != itr_end;  ++itr) {
-		// Extract character
-		d = *itr;
-
-		// Skip separating characters
-		if(!is_separating_char(d)) {
-			// Convert to digit
-			d -= 0x30;
-
-			// Throw error if character is non-octal
-			if(d > 7)
-				throw std::invalid_argument("Octal string argument contains invalid non-octal characters.");
-
-			// Append digit
-			*this <<= 3ull;
-			arr[0] |= static_cast<ull_t>(d);
-		}
-	}
-}
-
-
-// Decimal string constructor
-void LargeUnsignedInteger::construct_string_dec(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
-	char d;
-
-	// Iterate through characters
-	for(;  itr != itr_end;  ++itr) {
-		// Extract character
-		d = *itr;
-
-		// Skip separating characters
-		if(!is_separating_char(d)) {
-			// Convert to digit
-			d -= 0x30;
-
-			// Throw error if character is non-decimal
-			if(d > 9)
-				throw std::invalid_argument("Decimal string argument contains invalid non-decimal characters.");
-
-			// Append digit
-			*this *= 10ull;
-			*this += static_cast<ull_t>(d);
-		}
-	}
-}
-
-
-// Hexadecimal string constructor
-void LargeUnsignedInteger::construct_string_hex(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
-	char d;
-
-	// Iterate through characters
-	for(;  itr != itr_end;  ++itr) {
-		// Extract character
-		d = *itr;
-
-		// Skip separating characters
-		if(!is_separating_char(d)) {
-			// Convert character to value
-			if(d - 0x30 <= 9)		// digits 0-9
-				d -= 0x30;
-			else if(d - 0x41 <= 5)	// digits A-F
-				d -= 55;
-			else if(d - 0x61 <= 5)	// digits a-f
-				d -= 87;
-			// Throw error if character is non-hexadecimal
-			else
-				throw std::invalid_argument("Hexadecimal string argument contains invalid non-hexadecimal characters.");
-
-			// Append digit
-			*this <<= 4ull;
-			arr[0] |= static_cast<ull_t>(d);
-		}
-	}
-}
-
-
-// Reassign arr to new pointer, and refress arr_half
-void LargeUnsignedInteger::assign_arr(ull_t* arr_new) {
-	// Delete existing array
-	delete[] arr;
-
-	// Assign new array
-	arr = arr_new;
-
-	// Refresh arr_half
-	refresh_arr_half();
-}
-
-
-// Refresh arr_half to reference arr
-void LargeUnsignedInteger::refresh_arr_half() {
-	arr_half = reinterpret_cast<unsigned int*>(arr);
-}
-
-
-// Resize
-void LargeUnsignedInteger::resize(unsigned int len) {
-	// Skip if size is unchanged
-	if(len != num_segments) {
-		ull_t* new_arr = new ull_t[len];
-		unsigned int i = 0;
-
-		// Get smaller number of segments for initial copy
-		unsigned int min_segments = MIN(len, num_segments);
-
-		// Copy old array to new array
-		for(; i < min_segments; ++i)
-			new_arr[i] = arr[i];
-
-		// Fill remaining elements with zeros
-		for(; i < len; ++i)
-			new_arr[i] = 0;
-
-		// Reset members
-		assign_arr(new_arr);
-		num_segments = len;
-	}
-}
-
-
-// Resize to minimum needed words
-void LargeUnsignedInteger::trim() {
-	// Get minimum needed words
-	unsigned int min_segments = num_segments;
-	while(arr[--min_segments] == 0ull && min_segments > 0);
-
-	// Resize
-	resize(MAX(min_segments+1, 1));
-}
+
+#include "LargeUnsignedInteger.h"
+#include "LargeUnsignedDivisor.h"
+#include "MontgomeryContext.h"
+#include "LargeUnsignedDigitParser.h"
+#include <exception>
+#include <stdexcept>
+#include <utility>
+#include <climits>
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <cerrno>
+#include <cctype>
+#include <system_error>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#include <ostream>
+#include <istream>
+#include <string>
+#include <iomanip>
+
+
+// Static constants
+const unsigned int LargeUnsignedInteger::DEC_CHUNK_DIGITS = 19;
+const char LargeUnsignedInteger::DIGIT_CHARS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Digits per word, as the largest k with radix^k < 2^64, and radix^k. Indexed by radix
+const unsigned int LargeUnsignedInteger::RADIX_CHUNK_DIGITS[37] = {
+	0, 0,
+	63, 40, 31, 27, 24, 22, 21, 20,
+	19, 18, 17, 17, 16, 16, 15, 15,
+	15, 15, 14, 14, 14, 14, 13, 13,
+	13, 13, 13, 13, 13, 12, 12, 12,
+	12, 12, 12
+};
+const ull_t LargeUnsignedInteger::RADIX_CHUNK[37] = {
+	0, 0,
+	0x8000'0000'0000'0000ull, 0xA8B8'B452'291F'E821ull, 0x4000'0000'0000'0000ull, 0x6765'C793'FA10'079Dull,
+	0x41C2'1CB8'E100'0000ull, 0x3642'7987'5022'6111ull, 0x8000'0000'0000'0000ull, 0xA8B8'B452'291F'E821ull,
+	0x8AC7'2304'89E8'0000ull, 0x4D28'CB56'C33F'A539ull, 0x1ECA'170C'0000'0000ull, 0x780C'7372'621B'D74Dull,
+	0x1E39'A505'7D81'0000ull, 0x5B27'AC99'3DF9'7701ull, 0x1000'0000'0000'0000ull, 0x27B9'5E99'7E21'D9F1ull,
+	0x5DA0'E1E5'3C5C'8000ull, 0xD2AE'3299'C1C4'AEDBull, 0x16BC'C41E'9000'0000ull, 0x2D04'B7FD'D9C0'EF49ull,
+	0x5658'597B'CAA2'4000ull, 0xA0E2'0737'3760'9371ull, 0x0C29'E980'0000'0000ull, 0x14AD'F4B7'3203'34B9ull,
+	0x226E'D364'78BF'A000ull, 0x383D'9170'B85F'F80Bull, 0x5A3C'23E3'9C00'0000ull, 0x8E65'1373'8812'2BCDull,
+	0xDD41'BB36'D259'E000ull, 0x0AEE'5720'EE83'0681ull, 0x1000'0000'0000'0000ull, 0x1725'88AD'4F5F'0981ull,
+	0x211E'44F7'D02C'1000ull, 0x2EE5'6725'F06E'5C71ull, 0x41C2'1CB8'E100'0000ull
+};
+const unsigned int LargeUnsignedInteger::UINT_BITS = sizeof(unsigned int) * 8;
+const unsigned int LargeUnsignedInteger::ULL_BITS = sizeof(ull_t) * 8;
+
+
+// Tunable thresholds, in words
+unsigned int LargeUnsignedInteger::KARATSUBA_THRESHOLD = 24;
+unsigned int LargeUnsignedInteger::TOOM33_THRESHOLD = 120;
+unsigned int LargeUnsignedInteger::TOOM44_THRESHOLD = 400;
+unsigned int LargeUnsignedInteger::TOOM32_THRESHOLD = 120;
+unsigned int LargeUnsignedInteger::TOOM42_THRESHOLD = 120;
+unsigned int LargeUnsignedInteger::FFT_THRESHOLD = 1500;
+unsigned int LargeUnsignedInteger::FFT_RADIX3_THRESHOLD = 1500;
+unsigned int LargeUnsignedInteger::DIV_DC_THRESHOLD = 40;
+unsigned int LargeUnsignedInteger::DIV_NEWTON_THRESHOLD = 20000;
+unsigned int LargeUnsignedInteger::DEC_DC_THRESHOLD = 30;
+
+// Smallest operand that Toom splitting supports, in words
+const unsigned int LargeUnsignedInteger::TOOM_MIN_SIZE = 18;
+
+// NTT primes of the form c * 2^k + 1 below 2^62, with a primitive root of each. c is a multiple of 3, so lengths
+// 3 * 2^k have roots of unity too. Their product exceeds 2^182, enough for convolutions of 64-bit words up to length 2^55
+const ull_t LargeUnsignedInteger::FFT_PRIMES[3] = {
+		2'053'641'430'080'946'177ull,	// 57 * 2^55 + 1
+		2'485'986'994'308'513'793ull,	// 69 * 2^55 + 1
+		1'945'555'039'024'054'273ull	// 27 * 2^56 + 1
+};
+const ull_t LargeUnsignedInteger::FFT_GENERATORS[3] = {7ull, 5ull, 5ull};
+
+
+// Default Constructor
+LargeUnsignedInteger::LargeUnsignedInteger() :
+		num_segments	{1},
+		capacity		{1},
+		arr				{new ull_t[1]}
+{
+	refresh_arr_half();
+
+	arr[0] = 0;
+}
+
+
+// Scalar Initializing Constructor
+LargeUnsignedInteger::LargeUnsignedInteger(ull_t num) :
+		num_segments	{1},
+		capacity		{1},
+		arr				{new ull_t[1]}
+{
+	refresh_arr_half();
+
+	arr[0] = num;
+}
+
+
+// Array Initializing Constructor
+LargeUnsignedInteger::LargeUnsignedInteger(unsigned int len, const ull_t* num) :
+		num_segments	{len},
+		capacity		{len},
+		arr				{new ull_t[len]}
+{
+	refresh_arr_half();
+
+	for(;  len > 0;  --len)
+		arr[len-1] = num[len-1];
+
+	trim();
+}
+
+
+// String Initializing Constructor
+LargeUnsignedInteger::LargeUnsignedInteger(const std::string& str) :
+		LargeUnsignedInteger()	// call default constructor
+{
+	// Parse string
+	set(str);
+}
+
+
+// Copy Constructor
+LargeUnsignedInteger::LargeUnsignedInteger(const LargeUnsignedInteger& rhs) :
+		num_segments	{rhs.num_segments},
+		capacity		{rhs.num_segments},
+		arr				{new ull_t[rhs.num_segments]}
+{
+	refresh_arr_half();
+
+	// Copy rhs array to this array
+	for(unsigned int i = 0;  i < num_segments;  ++i)
+		this->arr[i] = rhs.arr[i];
+}
+
+
+// Move Constructor
+LargeUnsignedInteger::LargeUnsignedInteger(LargeUnsignedInteger&& rhs) :
+		num_segments	{rhs.num_segments},
+		capacity		{rhs.capacity},
+		arr				{rhs.arr}
+{
+	refresh_arr_half();
+
+	// Nullify rhs
+	rhs.num_segments = 0;
+	rhs.capacity = 0;
+	rhs.arr = nullptr;
+	rhs.refresh_arr_half();
+}
+
+
+// Destructor
+LargeUnsignedInteger::~LargeUnsignedInteger() {
+	delete[] arr;
+}
+
+
+// Return array size
+unsigned int LargeUnsignedInteger::get_size() const {
+	return num_segments;
+}
+
+
+// Check if value is zero
+bool LargeUnsignedInteger::is_zero() const {
+	return num_segments == 1 && arr[0] == 0;
+}
+
+
+// Set array to zero
+void LargeUnsignedInteger::reset() {
+	// Resize array, keeping capacity
+	resize(1);
+
+	// Set value to zero
+	arr[0] = 0;
+}
+
+
+// Set array to value
+void LargeUnsignedInteger::set(ull_t num) {
+	// Resize array, keeping capacity
+	resize(1);
+
+	// Set value
+	arr[0] = num;
+}
+
+
+// Set array to array value
+void LargeUnsignedInteger::set(unsigned int len, const ull_t* nums) {
+	// Reallocate if capacity is too small
+	if(capacity < len) {
+		assign_arr(new ull_t[len]);
+		capacity = len;
+	}
+	num_segments = len;
+
+	// Set values
+	for(;  len > 0;  --len)
+		arr[len-1] = nums[len-1];
+
+	// Trim object
+	trim();
+}
+
+
+// Set array to string value
+void LargeUnsignedInteger::set(const std::string& str) {
+	// Reset array
+	reset();
+
+	// Throw error for empty string
+	if(str.empty())
+		throw std::invalid_argument("String argument is empty.");
+
+	// Special case for input 0
+	if(str.length() == 1  &&  str[0] == '0')
+		return;
+
+	std::string::const_iterator itr = str.cbegin();
+	std::string::const_iterator itr_end = str.cend();
+
+	// Check for integer literal prefix
+	if(*itr == '0') {
+		// Number is hexadecimal
+		if(*(itr+1) == 'X' || *(itr+1) == 'x') {
+			itr += 2;
+			construct_string_hex(itr, itr_end);
+		}
+
+		// Number is binary
+		else if(*(itr+1) == 'B' || *(itr+1) == 'b') {
+			// Increment past prefix
+			itr += 2;
+			construct_string_bin(itr, itr_end);
+		}
+
+		// Number is octal
+		else {
+			// Increment past prefix
+			++itr;
+			construct_string_oct(itr, itr_end);
+		}
+	}
+
+	// Number is decimal
+	else {
+		construct_string_dec(itr, itr_end);
+	}
+
+	trim();
+}
+
+
+// Return low word from arr
+ull_t LargeUnsignedInteger::get_low_word() const {
+	return arr[0];
+}
+
+
+// Return the sum of two LargeUnsignedInteger objects as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator+(const LargeUnsignedInteger& rhs) const {
+	unsigned int min_segments;
+	const LargeUnsignedInteger* max_op;
+
+	// Determine which operand is smaller / larger
+	if(this->num_segments < rhs.num_segments) {
+		min_segments = this->num_segments;
+		max_op = &rhs;
+	} else {
+		min_segments = rhs.num_segments;
+		max_op = this;
+	}
+
+	// Initialize return object with larger number of segments
+	LargeUnsignedInteger rtn{};
+	rtn.resize(max_op->num_segments);
+
+	// Half adder sum. Needed to check for carry out
+	ull_t half_sum;
+
+	// Adder carry bit
+	ull_t carry = 0;
+
+	unsigned int i = 0;
+
+	// Full Adder
+	for(;  i < min_segments;  ++i) {
+		half_sum = this->arr[i] + rhs.arr[i];
+		rtn.arr[i] = half_sum + carry;
+		carry = (this->arr[i] > ULL_MAX - rhs.arr[i])  ||  (half_sum > ULL_MAX - carry);
+	}
+
+	// Half Adder to propagate carry
+	for(;  i < max_op->num_segments;  ++i) {
+		rtn.arr[i] = max_op->arr[i] + carry;
+		carry = max_op->arr[i] > ULL_MAX - carry;
+	}
+
+	// Add additional word for carry out
+	if(carry) {
+		rtn.resize(rtn.num_segments+1);
+		rtn.arr[rtn.num_segments-1] = 1;
+	}
+
+	return rtn;
+}
+
+
+// Return the sum of a LargeUnsignedInteger object with a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator+(const ull_t& rhs) const {
+	// Initialize return object
+	LargeUnsignedInteger rtn{};
+	rtn.resize(this->num_segments);
+
+	// Adder carry bit
+	ull_t carry;
+
+	// Add rhs
+	rtn.arr[0] = this->arr[0] + rhs;
+	carry = this->arr[0] > ULL_MAX - rhs;
+
+	// Half Adder to propagate carry
+	for(unsigned int i = 1;  i < this->num_segments;  ++i) {
+		rtn.arr[i] = this->arr[i] + carry;
+		carry = this->arr[i] > ULL_MAX - carry;
+	}
+
+	// Add additional word for carry out
+	if(carry) {
+		rtn.resize(rtn.num_segments+1);
+		rtn.arr[rtn.num_segments-1] = 1;
+	}
+
+	return rtn;
+}
+
+
+// Return the difference of two LargeUnsignedInteger objects as a new object
+// Behavior is undefined if LHS < RHS
+LargeUnsignedInteger LargeUnsignedInteger::operator-(const LargeUnsignedInteger& rhs) const {
+	unsigned int min_segments;
+	const LargeUnsignedInteger* max_op;
+
+	// Determine which operand is smaller / larger
+	if(this->num_segments < rhs.num_segments) {
+		min_segments = this->num_segments;
+		max_op = &rhs;
+	} else {
+		min_segments = rhs.num_segments;
+		max_op = this;
+	}
+
+	// Initialize return object with larger number of segments
+	LargeUnsignedInteger rtn{};
+	rtn.resize(max_op->num_segments);
+
+	// Half subtracter difference. Needed to check for borrow in
+	ull_t half_diff;
+
+	// Subtracter borrow bit
+	ull_t borrow = 0;
+
+	unsigned int i = 0;
+
+	// Full Subtracter
+	for(;  i < min_segments;  ++i) {
+		half_diff = this->arr[i] - rhs.arr[i];
+		rtn.arr[i] = half_diff - borrow;
+		borrow = (this->arr[i] < rhs.arr[i]) || (half_diff < borrow);
+	}
+
+	// This is larger array. Half Subtracter to propagate borrow
+	if(this == max_op) {
+		for(;  i < max_op->num_segments;  ++i) {
+			rtn.arr[i] = this->arr[i] - borrow;
+			borrow = this->arr[i] < borrow;
+		}
+	}
+	// This is smaller array. Full Subtracter for remaining RHS segments
+	else {
+		for(;  i < max_op->num_segments;  ++i) {
+			half_diff = -rhs.arr[i];
+			rtn.arr[i] = half_diff - borrow;
+			borrow = (0 < rhs.arr[i]) || (half_diff < borrow);
+		}
+	}
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+// Return the difference of a LargeUnsignedInteger object with a ull as a new object
+// Behavior is undefined if LHS < RHS
+LargeUnsignedInteger LargeUnsignedInteger::operator-(const ull_t& rhs) const {
+	// Initialize return object
+	LargeUnsignedInteger rtn{};
+	rtn.resize(this->num_segments);
+
+	// Subtracter borrow bits
+	ull_t borrow;
+
+	// Subtract RHS operand
+	rtn.arr[0] = this->arr[0] - rhs;
+	borrow = this->arr[0] < rhs;
+
+	// Half Subtracter to propagate borrow
+	for(unsigned int i = 1;  i < this->num_segments;  ++i) {
+		rtn.arr[i] = this->arr[i] - borrow;
+		borrow = this->arr[i] < borrow;
+	}
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the product of two LargeUnsignedInteger objects as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator*(const LargeUnsignedInteger& rhs) const {
+	// Use squaring when multiplying by self
+	if(&rhs == this)
+		return this->square();
+
+	// Initialize return object
+	LargeUnsignedInteger rtn;
+	rtn.resize(this->num_segments + rhs.num_segments);
+
+	// Multiply full words into return object
+	mul(rtn.arr, this->arr, this->num_segments, rhs.arr, rhs.num_segments);
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the product of a LargeUnsignedInteger object with a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator*(const ull_t& rhs) const {
+	// Initialize return object
+	LargeUnsignedInteger rtn;
+	rtn.resize(this->num_segments + 1);
+
+	// Multiply words in a single pass, storing carry-out as the high word
+	rtn.arr[this->num_segments] = mul_1(rtn.arr, this->arr, this->num_segments, rhs);
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the square of a LargeUnsignedInteger object as a new object
+LargeUnsignedInteger LargeUnsignedInteger::square() const {
+	// Initialize return object
+	LargeUnsignedInteger rtn;
+	rtn.resize(this->num_segments * 2);
+
+	// Square full words into return object
+	sqr(rtn.arr, this->arr, this->num_segments);
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return base^exp
+// Left-to-right binary exponentiation on the odd part of base, with the result length bounded upfront so that the
+// result and one working buffer are each allocated once. The power of two in base is applied as a final shift
+LargeUnsignedInteger LargeUnsignedInteger::pow(const LargeUnsignedInteger& base, ull_t exp) {
+	// Trivial powers
+	if(exp == 0)
+		return LargeUnsignedInteger{1ull};
+	if(exp == 1  ||  base.is_zero())
+		return base;
+
+	// Count trailing zero bits of base
+	unsigned int tz = 0;
+	while(base.arr[tz / ULL_BITS] == 0)
+		tz += ULL_BITS;
+	tz += __builtin_ctzll(base.arr[tz / ULL_BITS]);
+
+	// Check result length fits in words
+	unsigned int b_bits = base.bit_length();
+	if(exp > (UINT_MAX - 3ull) * ULL_BITS / b_bits)
+		throw std::invalid_argument("Power is too large.");
+
+	LargeUnsignedInteger odd = base >> tz;					// odd part of base
+	unsigned int bn = odd.num_segments;						// words of odd part
+	unsigned int on = (b_bits - tz) * exp / ULL_BITS + 2;	// bound on words of odd^exp, and of every product before it
+	ull_t shift = tz * exp;									// power of two of result
+	unsigned int sw = shift / ULL_BITS;						// shift words
+	unsigned int sb = shift % ULL_BITS;						// shift bits
+
+	// Result doubles as one of the two working buffers
+	LargeUnsignedInteger rtn;
+	rtn.resize(on + sw + 1);
+
+	ull_t* rp = rtn.arr;
+	ull_t* tp = new ull_t[on + mul_n_scratch_size(on/2 + 1)];
+	ull_t* scratch = tp + on;
+	unsigned int rn = bn;
+
+	for(unsigned int i = 0;  i < bn;  ++i)
+		rp[i] = odd.arr[i];
+
+	// Iterate through exponent bits below the top bit. Powers of 1 need no work
+	if(odd != 1ull) {
+		for(unsigned int i = ULL_BITS - 1 - __builtin_clzll(exp);  i-- > 0;  ) {
+			sqr_n(tp, rp, rn, scratch);
+			rn *= 2;
+			std::swap(rp, tp);
+			while(rn > 1  &&  rp[rn-1] == 0)
+				--rn;
+
+			if((exp >> i) & 1) {
+				// Single-word bases multiply in place
+				if(bn == 1) {
+					rp[rn] = mul_1(rp, rp, rn, odd.arr[0]);
+					rn += rp[rn] != 0;
+				}
+				else {
+					mul(tp, rp, rn, odd.arr, bn);
+					rn += bn;
+					std::swap(rp, tp);
+					while(rn > 1  &&  rp[rn-1] == 0)
+						--rn;
+				}
+			}
+		}
+	}
+
+	// Move odd power into the result, clearing words above it
+	if(rp != rtn.arr) {
+		for(unsigned int i = 0;  i < rn;  ++i)
+			rtn.arr[i] = rp[i];
+		tp = rp;
+	}
+	delete[] tp;
+
+	for(unsigned int i = rn;  i < rtn.num_segments;  ++i)
+		rtn.arr[i] = 0;
+
+	// Shift in place by the power of two
+	if(sb > 0)
+		rtn.arr[rn + sw] = lshift(rtn.arr + sw, rtn.arr, rn, sb);
+	else if(sw > 0)
+		for(unsigned int i = rn-1;  i < rn;  --i)
+			rtn.arr[i + sw] = rtn.arr[i];
+
+	for(unsigned int i = 0;  i < sw  &&  i < rn;  ++i)
+		rtn.arr[i] = 0;
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return base^exp mod mod
+// Left-to-right sliding window over the exponent, sized by its length. Odd moduli use Montgomery multiplication
+// on fixed word buffers. Even moduli reduce each product with a precomputed divisor
+LargeUnsignedInteger LargeUnsignedInteger::powm(const LargeUnsignedInteger& base, const LargeUnsignedInteger& exp, const LargeUnsignedInteger& mod) {
+	// Check for zero modulus
+	if(mod.is_zero())
+		throw std::invalid_argument("Division by zero.");
+
+	// Trivial results
+	if(mod == 1ull)
+		return LargeUnsignedInteger{};
+	if(exp.is_zero())
+		return LargeUnsignedInteger{1ull};
+
+	unsigned int e_bits = exp.bit_length();			// bits of exponent
+	unsigned int k = powm_window_size(e_bits);		// window size, in bits
+	unsigned int tn = 1u << (k-1);					// table entries, for odd powers base^1 .. base^(2^k - 1)
+	unsigned int w;									// window value
+	unsigned int w_bits;							// window length, in bits
+	bool first = true;								// result not yet assigned
+
+	LargeUnsignedInteger b = base < mod ? base : base % mod;
+
+	// Montgomery path
+	if(mod.arr[0] & 1) {
+		MontgomeryContext ctx{mod};
+		unsigned int n = mod.num_segments;
+
+		// Table of odd powers, then the result and base squared
+		ull_t* buf = new ull_t[(tn+2) * n];
+		ull_t* table = buf;
+		ull_t* rp = buf + tn*n;
+		ull_t* tp = rp + n;
+
+		for(unsigned int i = 0;  i < n;  ++i)
+			tp[i] = i < b.num_segments ? b.arr[i] : 0;
+		ctx.to_mont(table, tp);
+
+		if(tn > 1) {
+			ctx.sqr(tp, table);
+			for(unsigned int j = 1;  j < tn;  ++j)
+				ctx.mul(table + j*n, table + (j-1)*n, tp);
+		}
+
+		// Reverse-iterate through exponent bits
+		for(unsigned int i = e_bits-1;  i < e_bits; ) {
+			// Square for zero bit
+			if(!exp.get_bit(i)) {
+				ctx.sqr(rp, rp);
+				--i;
+				continue;
+			}
+
+			// Square for each window bit, then multiply by odd power
+			w = exp.get_window(i, k, w_bits);
+
+			if(first) {
+				for(unsigned int j = 0;  j < n;  ++j)
+					rp[j] = table[(w >> 1) * n + j];
+				first = false;
+			}
+			else {
+				for(unsigned int j = 0;  j < w_bits;  ++j)
+					ctx.sqr(rp, rp);
+				ctx.mul(rp, rp, table + (w >> 1) * n);
+			}
+
+			i -= w_bits;
+		}
+
+		// Convert result out of Montgomery form
+		ctx.from_mont(rp, rp);
+
+		LargeUnsignedInteger rtn{n, rp};
+		delete[] buf;
+
+		return rtn;
+	}
+
+	// Even modulus. Reduce by precomputed divisor
+	LargeUnsignedDivisor d{mod};
+	LargeUnsignedInteger* table = new LargeUnsignedInteger[tn];
+	LargeUnsignedInteger rtn;
+
+	table[0] = b;
+	if(tn > 1) {
+		LargeUnsignedInteger b2 = b.square() % d;
+		for(unsigned int j = 1;  j < tn;  ++j)
+			table[j] = table[j-1] * b2 % d;
+	}
+
+	// Reverse-iterate through exponent bits
+	for(unsigned int i = e_bits-1;  i < e_bits; ) {
+		// Square for zero bit
+		if(!exp.get_bit(i)) {
+			rtn = rtn.square() % d;
+			--i;
+			continue;
+		}
+
+		// Square for each window bit, then multiply by odd power
+		w = exp.get_window(i, k, w_bits);
+
+		if(first) {
+			rtn = table[w >> 1];
+			first = false;
+		}
+		else {
+			for(unsigned int j = 0;  j < w_bits;  ++j)
+				rtn = rtn.square() % d;
+			rtn = rtn * table[w >> 1] % d;
+		}
+
+		i -= w_bits;
+	}
+
+	delete[] table;
+
+	return rtn;
+}
+
+
+// Return base^exp mod mod in constant time with respect to exp, for secret exponents. mod must be odd
+// The exponent is padded with zero words to at least the modulus length, so leading zero words of a trimmed
+// exponent don't change the window count. Fixed window over every bit of the padded exponent, with a
+// multiplication for every window and a full table scan for every lookup. Working values stay at the modulus
+// length and are never trimmed. Exponents longer than the modulus take time by their own word count
+LargeUnsignedInteger LargeUnsignedInteger::powm_sec(const LargeUnsignedInteger& base, const LargeUnsignedInteger& exp, const LargeUnsignedInteger& mod) {
+	// Check modulus
+	if(!(mod.arr[0] & 1)  ||  mod == 1ull)
+		throw std::invalid_argument("Constant-time modulus must be odd and greater than 1.");
+
+	MontgomeryContext ctx{mod};
+	unsigned int n = mod.num_segments;
+
+	unsigned int en = exp.num_segments > n ? exp.num_segments : n;	// words of padded exponent
+	unsigned int e_bits = en * ULL_BITS;				// bits of padded exponent
+	unsigned int k = e_bits > 512 ? 5 : 4;				// window size, in bits
+	unsigned int tn = 1u << k;							// table entries, for powers base^0 .. base^(2^k - 1)
+	unsigned int nw = (e_bits + k-1) / k;				// windows
+	unsigned int pos;									// bit position of window
+	ull_t w;											// window value
+
+	// Table of powers, then the result, the selected power, the base, and the padded exponent
+	ull_t* buf = new ull_t[(tn+3) * n + en];
+	ull_t* table = buf;
+	ull_t* rp = buf + tn*n;
+	ull_t* tp = rp + n;
+	ull_t* bp = tp + n;
+	ull_t* ep = bp + n;
+
+	for(unsigned int i = 0;  i < en;  ++i)
+		ep[i] = i < exp.num_segments ? exp.arr[i] : 0;
+
+	LargeUnsignedInteger b = base < mod ? base : base % mod;
+	for(unsigned int i = 0;  i < n;  ++i)
+		bp[i] = i < b.num_segments ? b.arr[i] : 0;
+
+	const ull_t* one = ctx.get_one();
+	for(unsigned int i = 0;  i < n;  ++i)
+		table[i] = one[i];
+	ctx.to_mont(table + n, bp);
+	for(unsigned int j = 2;  j < tn;  ++j)
+		ctx.mul_sec(table + j*n, table + (j-1)*n, table + n);
+
+	// Top window assigns the result
+	pos = (nw-1) * k;
+	w = ep[pos / ULL_BITS] >> (pos % ULL_BITS);
+	sec_select(rp, table, tn, n, w);
+
+	// Reverse-iterate through remaining windows. Window positions depend only on the padded exponent length
+	for(unsigned int i = nw-2;  i < nw-1;  --i) {
+		for(unsigned int j = 0;  j < k;  ++j)
+			ctx.sqr_sec(rp, rp);
+
+		pos = i * k;
+		w = ep[pos / ULL_BITS] >> (pos % ULL_BITS);
+		if(pos % ULL_BITS > ULL_BITS - k  &&  pos / ULL_BITS + 1 < en)
+			w |= ep[pos / ULL_BITS + 1] << (ULL_BITS - pos % ULL_BITS);
+
+		sec_select(tp, table, tn, n, w & (tn-1));
+		ctx.mul_sec(rp, rp, tp);
+	}
+
+	// Convert result out of Montgomery form, by multiplying with 1
+	for(unsigned int i = 0;  i < n;  ++i)
+		bp[i] = i == 0;
+	ctx.mul_sec(rp, rp, bp);
+
+	LargeUnsignedInteger rtn{n, rp};
+	delete[] buf;
+
+	return rtn;
+}
+
+
+// Copy entry w of a table of tn entries of n words into rp
+// Every entry is read, and the match selected by mask, so the memory access pattern doesn't depend on w
+void LargeUnsignedInteger::sec_select(ull_t* rp, const ull_t* table, unsigned int tn, unsigned int n, ull_t w) {
+	ull_t mask;		// all ones for the matching entry
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		rp[i] = 0;
+
+	for(unsigned int j = 0;  j < tn;  ++j) {
+		mask = ((j ^ w) - 1) >> (ULL_BITS - 1);
+		mask = 0 - mask;
+
+		for(unsigned int i = 0;  i < n;  ++i)
+			rp[i] |= table[j*n + i] & mask;
+	}
+}
+
+
+// Return sliding window size, in bits, for an exponent of e_bits bits
+unsigned int LargeUnsignedInteger::powm_window_size(unsigned int e_bits) {
+	if(e_bits > 671)
+		return 6;
+	if(e_bits > 239)
+		return 5;
+	if(e_bits > 79)
+		return 4;
+	if(e_bits > 23)
+		return 3;
+	if(e_bits > 7)
+		return 2;
+
+	return 1;
+}
+
+
+// Return bit i
+bool LargeUnsignedInteger::get_bit(unsigned int i) const {
+	return i / ULL_BITS < this->num_segments  &&  (this->arr[i / ULL_BITS] >> (i % ULL_BITS) & 1);
+}
+
+
+// Return the odd window of at most k bits whose top bit is bit i, which must be set. Store its length in w_bits
+unsigned int LargeUnsignedInteger::get_window(unsigned int i, unsigned int k, unsigned int& w_bits) const {
+	// Lowest bit of window must be set
+	unsigned int low = i+1 > k ? i+1 - k : 0;
+	while(!this->get_bit(low))
+		++low;
+
+	// Gather window bits
+	unsigned int w = 0;
+	for(unsigned int j = i;  j >= low  &&  j <= i;  --j)
+		w = w << 1 | this->get_bit(j);
+
+	w_bits = i+1 - low;
+	return w;
+}
+
+
+// Return the quotient & remainder of one LargeUnsignedInteger object divided by another
+// Uses long division for short divisors and quotients, or Newton reciprocal division when both are long
+quot_rem LargeUnsignedInteger::div_mod(const LargeUnsignedInteger& rhs) const {
+	// Check for zero divisor
+	if(rhs.is_zero())
+		throw std::invalid_argument("Division by zero.");
+
+	// Newton division. Approximate reciprocal is enough, since the quotient is corrected afterwards
+	if(rhs.num_segments >= DIV_NEWTON_THRESHOLD  &&  this->num_segments >= rhs.num_segments + DIV_NEWTON_THRESHOLD) {
+		unsigned int n_bits = this->bit_length();
+		return this->div_mod(rhs, rhs.reciprocal_approx(n_bits), n_bits);
+	}
+
+	return this->div_mod_dc(rhs);
+}
+
+
+// Return the quotient & remainder of one LargeUnsignedInteger object divided by another, given the reciprocal
+// floor(2^n_bits / rhs) from rhs.reciprocal(n_bits). Requires LHS < 2^n_bits
+// The reciprocal can be reused for any number of dividends, so each division costs two multiplications
+quot_rem LargeUnsignedInteger::div_mod(const LargeUnsignedInteger& rhs, const LargeUnsignedInteger& rhs_recip, unsigned int n_bits) const {
+	// Check arguments
+	if(rhs.is_zero())
+		throw std::invalid_argument("Division by zero.");
+	if(this->bit_length() > n_bits)
+		throw std::invalid_argument("Dividend exceeds reciprocal precision.");
+
+	// Low bits of LHS below the divisor length shift the estimate by less than 1, so they are dropped. Quotient
+	// estimate is then at most 3 too small
+	unsigned int k = rhs.bit_length();
+	unsigned int t = k > ULL_BITS + 1 ? k - ULL_BITS - 1 : 0;
+	if(t > n_bits)
+		t = n_bits;
+
+	LargeUnsignedInteger quot = ((*this >> t) * rhs_recip) >> (n_bits - t);
+	LargeUnsignedInteger prod = quot * rhs;
+
+	// Correct estimate from an approximate reciprocal that was too large
+	while(prod > *this) {
+		--quot;
+		prod -= rhs;
+	}
+
+	LargeUnsignedInteger rem = *this - prod;
+
+	// Correct estimate that was too small
+	while(rem >= rhs) {
+		++quot;
+		rem -= rhs;
+	}
+
+	// Return quotient & remainder as pair
+	return std::make_pair(std::move(quot), std::move(rem));
+}
+
+
+// Return the quotient & remainder of one LargeUnsignedInteger object divided by another, by long division
+// Uses normalized long division (Knuth Algorithm D), or divide-and-conquer division for long divisors
+quot_rem LargeUnsignedInteger::div_mod_dc(const LargeUnsignedInteger& rhs) const {
+	// Single-word divisor
+	if(rhs.num_segments == 1)
+		return this->div_mod(rhs.arr[0]);
+
+	LargeUnsignedInteger quot;	// quotient
+	LargeUnsignedInteger rem;	// remainder
+
+	// Divisor is larger, so quotient is 0 and remainder is dividend
+	if(*this < rhs)
+		rem = *this;
+
+	// Perform division
+	else {
+		unsigned int nn = this->num_segments;	// words of dividend
+		unsigned int dn = rhs.num_segments;		// words of divisor
+
+		// Normalize, so that the top bit of the divisor is set. The dividend gains a high word
+		unsigned int shift = __builtin_clzll(rhs.arr[dn-1]);
+		ull_t* dp = new ull_t[dn];
+		ull_t* np = new ull_t[nn+1];
+
+		if(shift) {
+			lshift(dp, rhs.arr, dn, shift);
+			np[nn] = lshift(np, this->arr, nn, shift);
+		}
+		else {
+			for(unsigned int i = 0;  i < dn;  ++i)
+				dp[i] = rhs.arr[i];
+			for(unsigned int i = 0;  i < nn;  ++i)
+				np[i] = this->arr[i];
+			np[nn] = 0;
+		}
+
+		// Divide. The high word of the dividend is below the top word of the divisor, so the quotient fits nn+1-dn words
+		ull_t v = invert_limb(dp[dn-1]);
+		quot.resize(nn+1 - dn);
+		if(dn < DIV_DC_THRESHOLD)
+			div_basecase(quot.arr, np, nn+1, dp, dn, v);
+		else
+			div_dc(quot.arr, np, nn+1, dp, dn, v);
+
+		// Denormalize remainder
+		rem.resize(dn);
+		if(shift)
+			rshift(rem.arr, np, dn, shift);
+		else
+			for(unsigned int i = 0;  i < dn;  ++i)
+				rem.arr[i] = np[i];
+
+		delete[] dp;
+		delete[] np;
+
+		// Trim quotient & remainder
+		quot.trim();
+		rem.trim();
+	}
+
+	// Return quotient & remainder as pair
+	return std::make_pair(std::move(quot), std::move(rem));
+}
+
+
+// Return the reciprocal floor(2^n_bits / this)
+// Computed by Newton iteration, doubling precision at each step, followed by a final correction
+LargeUnsignedInteger LargeUnsignedInteger::reciprocal(unsigned int n_bits) const {
+	// Check for zero divisor
+	if(this->is_zero())
+		throw std::invalid_argument("Division by zero.");
+
+	LargeUnsignedInteger rtn = this->reciprocal_approx(n_bits);
+	LargeUnsignedInteger prod = *this * rtn;
+	LargeUnsignedInteger pow = LargeUnsignedInteger{1ull} << n_bits;
+
+	// Correct approximation that was too large
+	while(prod > pow) {
+		--rtn;
+		prod -= *this;
+	}
+
+	LargeUnsignedInteger rem = pow - prod;
+
+	// Correct approximation that was too small
+	while(rem >= *this) {
+		++rtn;
+		rem -= *this;
+	}
+
+	return rtn;
+}
+
+
+// Return an approximation of floor(2^n_bits / this), within a few units
+LargeUnsignedInteger LargeUnsignedInteger::reciprocal_approx(unsigned int n_bits) const {
+	unsigned int k = this->bit_length();	// bits of divisor
+
+	// Reciprocal is 0
+	if(n_bits < k)
+		return LargeUnsignedInteger{};
+
+	unsigned int m = n_bits - k;	// bits of reciprocal, less 1
+
+	// Only the top m bits of the divisor, plus guard bits, affect the reciprocal
+	if(k > m + 2 * ULL_BITS) {
+		unsigned int s = k - m - 2 * ULL_BITS;
+		return (*this >> s).reciprocal_approx(n_bits - s);
+	}
+
+	// Short reciprocal by long division
+	if(m / ULL_BITS < DIV_NEWTON_THRESHOLD  ||  m < 4 * ULL_BITS)
+		return (LargeUnsignedInteger{1ull} << n_bits).div_mod_dc(*this).first;
+
+	// Reciprocal z of about h bits, with relative error delta near 2^-h
+	unsigned int h = m / 2 + ULL_BITS;
+	unsigned int l = m - h;
+	LargeUnsignedInteger z = this->reciprocal_approx(n_bits - l);
+
+	// Newton step y = y0 + y0 * (2^n - x * y0) / 2^n, where y0 = z * 2^l. Relative error falls to delta^2
+	// The error term is near 2^(n-h), so bits of it below 2^(k-64) are dropped
+	LargeUnsignedInteger y = z << l;
+	LargeUnsignedInteger prod = (*this * z) << l;
+	LargeUnsignedInteger pow = LargeUnsignedInteger{1ull} << n_bits;
+	unsigned int s = k > ULL_BITS ? k - ULL_BITS : 0;
+
+	if(prod <= pow)
+		y += (z * ((pow - prod) >> s)) >> (n_bits - l - s);
+	else
+		y -= (z * ((prod - pow) >> s)) >> (n_bits - l - s);
+
+	return y;
+}
+
+
+// Return the number of significant bits
+unsigned int LargeUnsignedInteger::bit_length() const {
+	ull_t top = this->arr[this->num_segments-1];
+	return (this->num_segments - 1) * ULL_BITS + (top ? ULL_BITS - __builtin_clzll(top) : 0);
+}
+
+
+// Return the quotient & remainder of a LargeUnsignedInteger object divided by a ull
+// Uses one reciprocal division per word
+quot_rem LargeUnsignedInteger::div_mod(const ull_t& rhs) const {
+	// Check for zero divisor
+	if(rhs == 0)
+		throw std::invalid_argument("Division by zero.");
+
+	LargeUnsignedInteger quot;	// quotient
+
+	// Divide one word per step
+	quot.resize(this->num_segments);
+	LargeUnsignedInteger rem{div_1(quot.arr, this->arr, this->num_segments, rhs)};
+
+	// Trim quotient
+	quot.trim();
+
+	// Return quotient & remainder as pair
+	return std::make_pair(std::move(quot), std::move(rem));
+}
+
+
+// Return the quotient & remainder of a LargeUnsignedInteger object divided by a precomputed divisor
+quot_rem LargeUnsignedInteger::div_mod(const LargeUnsignedDivisor& rhs) const {
+	return rhs.div_mod(*this);
+}
+
+
+// Return the quotient of one LargeUnsignedInteger object divided by another as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator/(const LargeUnsignedInteger& rhs) const {
+	quot_rem res = this->div_mod(rhs);
+	return res.first;
+}
+
+
+// Return the quotient of a LargeUnsignedInteger object divided by a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator/(const ull_t& rhs) const {
+	// Check for zero divisor
+	if(rhs == 0)
+		throw std::invalid_argument("Division by zero.");
+
+	// Initialize return object
+	LargeUnsignedInteger rtn;
+	rtn.resize(this->num_segments);
+
+	// Divide one word per step, discarding remainder
+	div_1(rtn.arr, this->arr, this->num_segments, rhs);
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the quotient of a LargeUnsignedInteger object divided by a precomputed divisor as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator/(const LargeUnsignedDivisor& rhs) const {
+	return rhs.quot(*this);
+}
+
+
+// Return the remainder of one LargeUnsignedInteger object divided by another as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator%(const LargeUnsignedInteger& rhs) const {
+	quot_rem res = this->div_mod(rhs);
+	return res.second;
+}
+
+
+// Return the remainder of a LargeUnsignedInteger object divided by a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator%(const ull_t& rhs) const {
+	// Check for zero divisor
+	if(rhs == 0)
+		throw std::invalid_argument("Division by zero.");
+
+	return LargeUnsignedInteger{mod_1(this->arr, this->num_segments, rhs)};
+}
+
+
+// Return the remainder of a LargeUnsignedInteger object divided by a precomputed divisor as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator%(const LargeUnsignedDivisor& rhs) const {
+	return rhs.rem(*this);
+}
+
+
+// Return the left-shift of a LargeUnsignedInteger object by a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator<<(const ull_t& rhs) const {
+	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
+	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
+	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
+
+	// Construct return object
+	LargeUnsignedInteger rtn;
+
+	// Resize object to append extra bit-shift cycles and potential overflow
+	rtn.resize(this->num_segments + shift_cycles + 1);
+
+	// Reverse-iterate through words
+	for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i) {
+		// Catch 64-bit shift error
+		if(shift_bits > 0)
+			// Append high-portion of word
+			rtn.arr[i+1+shift_cycles] |= this->arr[i] >> shift_bits_rev;
+
+		// Shift low-portion of word
+		rtn.arr[i+shift_cycles] = this->arr[i] << shift_bits;
+	}
+
+	// Trim return object
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the right-shift of a LargeUnsignedInteger object by a ull as a new object
+LargeUnsignedInteger LargeUnsignedInteger::operator>>(const ull_t& rhs) const {
+	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
+	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
+	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
+
+	// Construct return object
+	LargeUnsignedInteger rtn;
+
+	// Skip if all words are shifted out
+	if(shift_cycles < this->num_segments) {
+		// Resize object to remove cleared bit-shift cycles
+		rtn.resize(this->num_segments - shift_cycles);
+
+		// Iterate through words
+		for(unsigned int i = shift_cycles;  i < this->num_segments-1;  ++i) {
+			// Shift high-portion of low-word
+			rtn.arr[i-shift_cycles] = this->arr[i] >> shift_bits;
+
+			// Catch 64-bit shift error
+			if(shift_bits > 0)
+				// Append low-portion of high-word
+				rtn.arr[i-shift_cycles] |= this->arr[i+1] << shift_bits_rev;
+		}
+
+		// Shift low-portion of highest word
+		rtn.arr[rtn.num_segments-1] = this->arr[this->num_segments-1] >> shift_bits;
+
+		// Trim object
+		rtn.trim();
+	}
+
+	return rtn;
+}
+
+
+// Check if a LargeUnsignedInteger object is less than another object
+bool LargeUnsignedInteger::operator<(const LargeUnsignedInteger& rhs) const {
+	// Compare array sizes
+	if(this->num_segments < rhs.num_segments)
+		return true;
+	if(this->num_segments > rhs.num_segments)
+		return false;
+
+	// Reverse-iterate through array words
+	for(unsigned int i = this->num_segments-1;  i < this->num_segments;  --i) {
+		if(this->arr[i] < rhs.arr[i])
+			return true;
+		if(this->arr[i] > rhs.arr[i])
+			return false;
+	}
+
+	// Numbers are equal
+	return false;
+}
+
+
+// Check if a LargeUnsignedInteger object is less than a ull
+bool LargeUnsignedInteger::operator<(const ull_t& rhs) const {
+	// Check if array is multiple words
+	if(this->num_segments > 1)
+		return false;
+
+	// Compare directly
+	return this->arr[0] < rhs;
+}
+
+
+// Check if a LargeUnsignedInteger object is greater than another object
+bool LargeUnsignedInteger::operator>(const LargeUnsignedInteger& rhs) const {
+	return rhs < *this;
+}
+
+
+// Check if a LargeUnsignedInteger object is greater than a ull
+bool LargeUnsignedInteger::operator>(const ull_t& rhs) const {
+	// Check if array is multiple words
+	if(this->num_segments > 1)
+		return true;
+
+	// Compare directly
+	return this->arr[0] > rhs;
+}
+
+
+// Check if a LargeUnsignedInteger object is less than or equal to another object
+bool LargeUnsignedInteger::operator<=(const LargeUnsignedInteger& rhs) const {
+	return !(rhs < *this);
+}
+
+
+// Check if a LargeUnsignedInteger object is less than or equal to a ull
+bool LargeUnsignedInteger::operator<=(const ull_t& rhs) const {
+	return !(*this > rhs);
+}
+
+
+// Check if a LargeUnsignedInteger object is greater than or equal to another object
+bool LargeUnsignedInteger::operator>=(const LargeUnsignedInteger& rhs) const {
+	return !(*this < rhs);
+}
+
+
+// Check if a LargeUnsignedInteger object is greater than or equal to a ull
+bool LargeUnsignedInteger::operator>=(const ull_t& rhs) const {
+	return !(*this < rhs);
+}
+
+
+// Check if a LargeUnsignedInteger object is equal to another object
+bool LargeUnsignedInteger::operator==(const LargeUnsignedInteger& rhs) const {
+	// Compare array sizes
+	if(this->num_segments != rhs.num_segments)
+		return false;
+
+	// Iterate through array words
+	for(unsigned int i = 0;  i < this->num_segments;  ++i) {
+		if(this->arr[i] != rhs.arr[i])
+			return false;
+	}
+
+	// Numbers are equal
+	return true;
+}
+
+
+// Check if a LargeUnsignedInteger object is equal to a ull
+bool LargeUnsignedInteger::operator==(const ull_t& rhs) const {
+	// Check if array is multiple words
+	if(this->num_segments > 1)
+		return false;
+
+	// Compare directly
+	return this->arr[0] == rhs;
+}
+
+
+// Check if a LargeUnsignedInteger object is not equal to another object
+bool LargeUnsignedInteger::operator!=(const LargeUnsignedInteger& rhs) const {
+	return !(*this == rhs);
+}
+
+
+// Check if a LargeUnsignedInteger object is not equal to a ull
+bool LargeUnsignedInteger::operator!=(const ull_t& rhs) const {
+	return !(*this == rhs);
+}
+
+
+// Accumulate the sum of two LargeUnsignedInteger objects into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator+=(const LargeUnsignedInteger& rhs) {
+	// Get min segments
+	unsigned int min_segments = MIN(this->num_segments, rhs.num_segments);
+
+	// Resize this
+	this->resize(MAX(this->num_segments, rhs.num_segments));
+
+	// Half adder sum. Needed to check for carry out
+	ull_t half_sum;
+
+	// Adder carry bit
+	ull_t carry = 0;
+
+	unsigned int i = 0;
+
+	// Full Adder through min_segments
+	for(;  i < min_segments;  ++i) {
+		half_sum = rhs.arr[i] + carry;
+		carry = (this->arr[i] > ULL_MAX - half_sum)  ||  (rhs.arr[i] > ULL_MAX - carry);
+		this->arr[i] += half_sum;
+	}
+
+	// This is smaller array. Full Adder for remaining RHS segments
+	if(rhs.num_segments > min_segments) {
+		// Process remaining segments
+		for(;  i < rhs.num_segments;  ++i) {
+			this->arr[i] += rhs.arr[i] + carry;
+			carry = rhs.arr[i] > ULL_MAX - carry;
+		}
+	}
+	// This is larger array. Half Adder to propagate carry
+	else {
+		// Process remaining segments
+		for(;  i < this->num_segments && carry;  ++i) {
+			half_sum = carry;
+			carry = this->arr[i] > ULL_MAX - half_sum;
+			this->arr[i] += half_sum;
+		}
+	}
+
+	// Add additional word for carry out
+	if(carry) {
+		this->resize(this->num_segments+1);
+		this->arr[this->num_segments-1] = 1;
+	}
+
+	return *this;
+}
+
+
+// Accumulate the sum of a LargeUnsignedInteger object with a ull into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator+=(const ull_t& rhs) {
+	// Half adder sum. Needed to check for carry out
+	ull_t half_sum;
+
+	// Adder carry bit
+	ull_t carry;
+
+	// Add RHS operand
+	carry = this->arr[0] > ULL_MAX - rhs;
+	this->arr[0] += rhs;
+
+	// Half Adder to propagate carry
+	for(unsigned int i = 1;  i < this->num_segments && carry;  ++i) {
+		half_sum = carry;
+		carry = this->arr[i] > ULL_MAX - carry;
+		this->arr[i] += half_sum;
+	}
+
+	// If LHS operand is dynamic and carry out, resize to propagate carry
+	if(carry) {
+		this->resize(this->num_segments+1);
+		this->arr[this->num_segments-1] = 1;
+	}
+
+	return *this;
+}
+
+
+// Accumulate the difference of two LargeUnsignedInteger objects into the LHS
+// Behavior is undefined if LHS < RHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator-=(const LargeUnsignedInteger& rhs) {
+	// Get smaller number of segments for initial accumulation
+	unsigned int min_segments = MIN(this->num_segments, rhs.num_segments);
+
+	// Resize this
+	this->resize(MAX(this->num_segments, rhs.num_segments));
+
+	// Half subtracter sum. Needed to check for borrow in
+	ull_t half_sum;
+
+	// Subtracter borrow bits
+	ull_t borrow = 0;
+
+	unsigned int i = 0;
+
+	// Full Subtracter
+	for(;  i < min_segments;  ++i) {
+		half_sum = rhs.arr[i] + borrow;
+		borrow = (rhs.arr[i] > ULL_MAX - borrow) || (this->arr[i] < half_sum);
+		this->arr[i] -= half_sum;
+	}
+
+	// This is smaller array. Full Subtracter for remaining RHS segments.
+	if(rhs.num_segments > min_segments) {
+		for(;  i < rhs.num_segments;  ++i) {
+			half_sum = rhs.arr[i] + borrow;
+			borrow = (rhs.arr[i] > ULL_MAX - borrow) || (this->arr[i] < half_sum);
+			this->arr[i] -= half_sum;
+		}
+	}
+	// This is larger array. Full Subtracter to propagate borrow
+	else {
+		for(;  i < this->num_segments && borrow;  ++i) {
+			half_sum = borrow;
+			borrow = this->arr[i] < borrow;
+			this->arr[i] -= half_sum;
+		}
+	}
+
+	// Trim this
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the difference of a LargeUnsignedInteger object with a ull into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator-=(const ull_t& rhs) {
+	// Half subtracter sum. Needed to check for borrow in
+	ull_t half_sum;
+
+	// Subtracter borrow bit
+	ull_t borrow;
+
+	// Subtract RHS operand
+	borrow = this->arr[0] < rhs;
+	this->arr[0] -= rhs;
+
+	// Full Subtracter to propagate borrow
+	for(unsigned int i = 1;  i < this->num_segments && borrow;  ++i) {
+		half_sum = borrow;
+		borrow = this->arr[i] < borrow;
+		this->arr[i] -= half_sum;
+	}
+
+	// Trim this
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the product of two LargeUnsignedInteger objects into the LHS
+// Reuses the existing array when it has capacity for the product. A long LHS is copied into scratch freed on return
+LargeUnsignedInteger& LargeUnsignedInteger::operator*=(const LargeUnsignedInteger& rhs) {
+	// Single-word multiplier, in one pass over this
+	if(rhs.num_segments == 1) {
+		ull_t v = rhs.arr[0];
+		return *this *= v;
+	}
+
+	unsigned int un = this->num_segments;	// words of this before multiplication
+	unsigned int vn = rhs.num_segments;		// words of rhs
+	unsigned int len = un + vn;				// product length
+
+	// Grow geometrically, so that repeated accumulation reallocates rarely
+	if(len > this->capacity)
+		this->reserve(len > 2 * this->capacity ? len : 2 * this->capacity);
+
+	// Short this: schoolbook product formed in place. Reverse-iterate through words of this, so that each word
+	// is read before the partial products reach it
+	if(un < KARATSUBA_THRESHOLD  &&  &rhs != this) {
+		this->resize(len);
+
+		ull_t word;		// multiplicand word of this
+		ull_t carry;	// carry word out of each row
+
+		for(unsigned int i = un-1;  i < un;  --i) {
+			word = this->arr[i];
+			this->arr[i] = 0;
+
+			// Carry stops at the first word it doesn't overflow
+			carry = addmul_1(this->arr+i, rhs.arr, vn, word);
+			add_1(this->arr+i+vn, this->arr+i+vn, len-i-vn, carry);
+		}
+	}
+
+	// Long this: copy this into scratch, followed by the product's scratch, and multiply into this. A short rhs
+	// takes basecase rows over the words of the copy
+	else {
+		unsigned int sn = (&rhs == this) ? mul_n_scratch_size(un) : mul_scratch_size(un, vn);
+		ull_t* up = new ull_t[un + sn];
+		for(unsigned int i = 0;  i < un;  ++i)
+			up[i] = this->arr[i];
+
+		this->resize(len);
+
+		if(&rhs == this)
+			sqr_n(this->arr, up, un, up + un);
+		else
+			mul(this->arr, up, un, rhs.arr, vn, up + un);
+
+		delete[] up;
+	}
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the product of a LargeUnsignedInteger object with a ull into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator*=(const ull_t& rhs) {
+	// Multiply words in place in a single pass
+	ull_t carry = mul_1(this->arr, this->arr, this->num_segments, rhs);
+
+	// Append carry-out word, growing geometrically for repeated accumulation
+	if(carry) {
+		if(this->num_segments == this->capacity)
+			this->reserve(2 * this->capacity);
+
+		this->resize(this->num_segments + 1);
+		this->arr[this->num_segments-1] = carry;
+	}
+
+	// Trim object, for a zero multiplier
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the product of two LargeUnsignedInteger objects into the LHS, without forming a product object
+LargeUnsignedInteger& LargeUnsignedInteger::addmul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b) {
+	// Skip zero product
+	if(a.is_zero()  ||  b.is_zero())
+		return *this;
+
+	const ull_t* up = a.arr;			// longer operand
+	const ull_t* vp = b.arr;			// shorter operand
+	unsigned int un = a.num_segments;	// words of up
+	unsigned int vn = b.num_segments;	// words of vp
+
+	// Make up the longer operand
+	if(un < vn) {
+		std::swap(up, vp);
+		std::swap(un, vn);
+	}
+
+	unsigned int pn = un + vn;											// product length
+	unsigned int len = (this->num_segments > pn ? this->num_segments : pn) + 1;	// accumulator length
+
+	// Schoolbook rows accumulated directly into this, unless an operand is this
+	if(vn < KARATSUBA_THRESHOLD  &&  &a != this  &&  &b != this) {
+		if(len > this->capacity)
+			this->reserve(len > 2 * this->capacity ? len : 2 * this->capacity);
+		this->resize(len);
+
+		ull_t carry;	// carry word out of each row
+
+		// Carry stops at the first word it doesn't overflow, so a long accumulator isn't swept per row
+		for(unsigned int j = 0;  j < vn;  ++j) {
+			carry = addmul_1(this->arr+j, up, un, vp[j]);
+			add_1(this->arr+j+un, this->arr+j+un, len-j-un, carry);
+		}
+	}
+
+	// Subquadratic product into scratch, then added into this
+	else {
+		ull_t* scratch = new ull_t[pn];
+		mul(scratch, up, un, vp, vn);
+
+		if(len > this->capacity)
+			this->reserve(len > 2 * this->capacity ? len : 2 * this->capacity);
+		this->resize(len);
+
+		add(this->arr, this->arr, len, scratch, pn);
+
+		delete[] scratch;
+	}
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the product of a LargeUnsignedInteger object with a ull into the LHS, without forming a product object
+LargeUnsignedInteger& LargeUnsignedInteger::addmul(const LargeUnsignedInteger& a, const ull_t& b) {
+	// Skip zero product
+	if(b == 0)
+		return *this;
+
+	unsigned int an = a.num_segments;												// words of a
+	unsigned int len = (this->num_segments > an ? this->num_segments : an) + 1;	// accumulator length
+
+	// Grow geometrically, so that repeated accumulation reallocates rarely
+	if(len > this->capacity)
+		this->reserve(len > 2 * this->capacity ? len : 2 * this->capacity);
+	this->resize(len);
+
+	// Single row. Each word of a is read before the same word of this is written, so a may be this
+	ull_t carry = addmul_1(this->arr, a.arr, an, b);
+	add_1(this->arr+an, this->arr+an, len-an, carry);
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Deduct the product of two LargeUnsignedInteger objects from the LHS, without forming a product object
+// Behavior is undefined if LHS < a * b
+LargeUnsignedInteger& LargeUnsignedInteger::submul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b) {
+	// Skip zero product
+	if(a.is_zero()  ||  b.is_zero())
+		return *this;
+
+	const ull_t* up = a.arr;			// longer operand
+	const ull_t* vp = b.arr;			// shorter operand
+	unsigned int un = a.num_segments;	// words of up
+	unsigned int vn = b.num_segments;	// words of vp
+
+	// Make up the longer operand
+	if(un < vn) {
+		std::swap(up, vp);
+		std::swap(un, vn);
+	}
+
+	unsigned int pn = un + vn;											// product length
+	unsigned int len = this->num_segments > pn ? this->num_segments : pn;	// accumulator length
+
+	// Schoolbook rows deducted directly from this, unless an operand is this
+	if(vn < KARATSUBA_THRESHOLD  &&  &a != this  &&  &b != this) {
+		// Product can't exceed this, so this has at least pn-1 words. Pad so every row fits
+		this->resize(len);
+
+		ull_t borrow;	// borrow word out of each row
+
+		// Borrow stops at the first word it doesn't underflow, so a long accumulator isn't swept per row
+		for(unsigned int j = 0;  j < vn;  ++j) {
+			borrow = submul_1(this->arr+j, up, un, vp[j]);
+			sub_1(this->arr+j+un, this->arr+j+un, len-j-un, borrow);
+		}
+	}
+
+	// Subquadratic product into scratch, then deducted from this
+	else {
+		ull_t* scratch = new ull_t[pn];
+		mul(scratch, up, un, vp, vn);
+
+		this->resize(len);
+		sub(this->arr, this->arr, len, scratch, pn);
+
+		delete[] scratch;
+	}
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Deduct the product of a LargeUnsignedInteger object with a ull from the LHS, without forming a product object
+// Behavior is undefined if LHS < a * b
+LargeUnsignedInteger& LargeUnsignedInteger::submul(const LargeUnsignedInteger& a, const ull_t& b) {
+	// Skip zero product
+	if(b == 0)
+		return *this;
+
+	unsigned int an = a.num_segments;	// words of a
+
+	// Pad so the row fits
+	if(this->num_segments < an)
+		this->resize(an);
+
+	// Single row. Each word of a is read before the same word of this is written, so a may be this
+	ull_t borrow = submul_1(this->arr, a.arr, an, b);
+	sub_1(this->arr+an, this->arr+an, this->num_segments-an, borrow);
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the quotient of one LargeUnsignedInteger object divided by another into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator/=(const LargeUnsignedInteger& rhs) {
+	quot_rem res = this->div_mod(rhs);
+	*this = std::move(res.first);
+	return *this;
+}
+
+
+// Accumulate the quotient of one LargeUnsignedInteger object divided by a ull the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator/=(const ull_t& rhs) {
+	// Check for zero divisor
+	if(rhs == 0)
+		throw std::invalid_argument("Division by zero.");
+
+	// Divide in place, one word per step
+	div_1(this->arr, this->arr, this->num_segments, rhs);
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the quotient of a LargeUnsignedInteger object divided by a precomputed divisor into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator/=(const LargeUnsignedDivisor& rhs) {
+	*this = rhs.quot(*this);
+	return *this;
+}
+
+
+// Accumulate the remainder of one LargeUnsignedInteger object divided by another into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator%=(const LargeUnsignedInteger& rhs) {
+	quot_rem res = this->div_mod(rhs);
+	*this = std::move(res.second);
+	return *this;
+}
+
+
+// Accumulate the remainder of one LargeUnsignedInteger object divided by a ull the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator%=(const ull_t& rhs) {
+	// Check for zero divisor
+	if(rhs == 0)
+		throw std::invalid_argument("Division by zero.");
+
+	this->set(mod_1(this->arr, this->num_segments, rhs));
+	return *this;
+}
+
+
+// Accumulate the remainder of a LargeUnsignedInteger object divided by a precomputed divisor into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator%=(const LargeUnsignedDivisor& rhs) {
+	*this = rhs.rem(*this);
+	return *this;
+}
+
+
+// Accumulate the left-shift of a LargeUnsignedInteger object by a ull into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator<<=(const ull_t& rhs) {
+	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
+	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
+	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
+
+	// Resize object to append extra bit-shift cycles and potential overflow
+	this->resize(this->num_segments + shift_cycles + 1);
+
+	// Reverse-iterate through words
+	for(unsigned int i = this->num_segments-2-shift_cycles;  i < this->num_segments;  --i) {
+		// Catch 64-bit shift error
+		if(shift_bits > 0)
+			// Append high-portion of word
+			this->arr[i+1+shift_cycles] |= static_cast<ull_t>(this->arr[i]) >> shift_bits_rev;
+
+		// Shift low-portion of word
+		this->arr[i+shift_cycles] = this->arr[i] << shift_bits;
+	}
+
+	// Clear cycled words
+	for(unsigned int i = 0;  i < shift_cycles;  ++i)
+		this->arr[i] = 0ull;
+
+	// Trim object
+	this->trim();
+
+	return *this;
+}
+
+
+// Accumulate the right-shift of a LargeUnsignedInteger object by a ull into the LHS
+LargeUnsignedInteger& LargeUnsignedInteger::operator>>=(const ull_t& rhs) {
+	ull_t shift_cycles = rhs / ULL_BITS;			// Number of times the bit-shift will wrap
+	ull_t shift_bits = rhs % ULL_BITS;				// Remaining bit-shift
+	ull_t shift_bits_rev = ULL_BITS - shift_bits;	// Bits for reverse-shift
+
+	// Reset this if all words are shifted out
+	if(shift_cycles >= this->num_segments)
+		this->reset();
+
+	// Do right-shift
+	else {
+		// Iterate through words
+		for(unsigned int i = shift_cycles;  i < this->num_segments-1;  ++i) {
+			// Shift high-portion of low-word
+			this->arr[i-shift_cycles] = this->arr[i] >> shift_bits;
+
+			// Catch 64-bit shift error
+			if(shift_bits > 0)
+				// Append low-portion of high-word
+				this->arr[i-shift_cycles] |= this->arr[i+1] << shift_bits_rev;
+		}
+
+		// Shift low-portion of highest word
+		this->arr[this->num_segments-1-shift_cycles] = this->arr[this->num_segments-1] >> shift_bits;
+
+		// Clear cycled words
+		for(unsigned int i = this->num_segments-shift_cycles;  i < this->num_segments;  ++i)
+			this->arr[i] = 0;
+
+		// Trim object
+		this->trim();
+	}
+
+	return *this;
+}
+
+
+// Prefix increment
+LargeUnsignedInteger& LargeUnsignedInteger::operator++() {
+	// Increment words until no more overflow
+	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == 0);  ++i)
+		++this->arr[i];
+
+	// Add additional word for overflow
+	if(this->arr[this->num_segments-1] == 0) {
+		this->resize(this->num_segments+1);
+		this->arr[this->num_segments-1] = 1;
+	}
+
+	return *this;
+}
+
+
+// Prefix decrement
+LargeUnsignedInteger& LargeUnsignedInteger::operator--() {
+	// Decrement words until no more underflow
+	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == ULL_MAX);  ++i)
+		--this->arr[i];
+
+	// Trim this
+	this->trim();
+
+	return *this;
+}
+
+
+// Postfix increment
+LargeUnsignedInteger LargeUnsignedInteger::operator++(int) {
+	// Save copy of this before increment
+	LargeUnsignedInteger this_old = *this;
+
+	// Increment words until no more overflow
+	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == 0);  ++i)
+		this->arr[i]++;
+
+	// Add additional word for overflow
+	if(this->arr[this->num_segments-1] == 0) {
+		this->resize(this->num_segments+1);
+		this->arr[this->num_segments-1] = 1;
+	}
+
+	return this_old;
+}
+
+
+// Postfix decrement
+LargeUnsignedInteger LargeUnsignedInteger::operator--(int) {
+	// Save copy of this before decrement
+	LargeUnsignedInteger this_old = *this;
+
+	// Decrement words until no more underflow
+	for(unsigned int i = 0;  i == 0 || (i < this->num_segments && this->arr[i-1] == ULL_MAX);  ++i)
+		this->arr[i]--;
+
+	// Trim this
+	this->trim();
+
+	return this_old;
+}
+
+
+// Copy assignment
+// Copy values of RHS array into this array
+LargeUnsignedInteger& LargeUnsignedInteger::operator=(const LargeUnsignedInteger& rhs) {
+	// Do nothing if self-assignment
+	if(this != &rhs) {
+		// Reallocate if capacity is too small
+		if(this->capacity < rhs.num_segments) {
+			this->assign_arr(new ull_t[rhs.num_segments]);
+			this->capacity = rhs.num_segments;
+		}
+		this->num_segments = rhs.num_segments;
+
+		// Copy rhs array to this array
+		for(unsigned int i = 0; i < this->num_segments; ++i)
+			this->arr[i] = rhs.arr[i];
+	}
+
+	return *this;
+}
+
+
+// Copy assignment scalar
+// Copy value of RHS into this array
+LargeUnsignedInteger& LargeUnsignedInteger::operator=(const ull_t& rhs) {
+	this->set(rhs);
+	return *this;
+}
+
+
+// Move assignment
+// Move values of RHS array into this array
+LargeUnsignedInteger& LargeUnsignedInteger::operator=(LargeUnsignedInteger&& rhs) {
+	// Do nothing if self-assignment
+	if(this != &rhs) {
+		// Reassign array
+		this->assign_arr(rhs.arr);
+		this->num_segments = rhs.num_segments;
+		this->capacity = rhs.capacity;
+
+		// Nullify rhs
+		rhs.num_segments = 0;
+		rhs.capacity = 0;
+		rhs.arr = nullptr;
+		rhs.refresh_arr_half();
+	}
+
+	return *this;
+}
+
+
+// Move assignment scalar
+// Move value of RHS into this array
+LargeUnsignedInteger& LargeUnsignedInteger::operator=(ull_t&& rhs) {
+	this->set(rhs);
+	rhs = 0;
+	return *this;
+}
+
+
+// Return radix^(RADIX_CHUNK_DIGITS[radix] * 2^k), for k below RADIX_POWERS_MAX. Computed by repeated squaring on
+// first use, and cached per radix
+const LargeUnsignedInteger& LargeUnsignedInteger::radix_power(unsigned int radix, unsigned int k) {
+	static LargeUnsignedInteger powers[37][RADIX_POWERS_MAX];
+	static std::atomic<unsigned int> powers_len[37];
+	static std::mutex powers_mutex;
+
+	if(k >= RADIX_POWERS_MAX)
+		throw std::length_error("Radix power is too large.");
+
+	// Entries are never changed once published by powers_len, so cached powers are read without the lock
+	LargeUnsignedInteger* rp = powers[radix];
+	if(k < powers_len[radix].load(std::memory_order_acquire))
+		return rp[k];
+
+	std::lock_guard<std::mutex> lock{powers_mutex};
+
+	unsigned int len = powers_len[radix].load(std::memory_order_relaxed);
+
+	if(len == 0) {
+		rp[len++] = RADIX_CHUNK[radix];
+		powers_len[radix].store(len, std::memory_order_release);
+	}
+	while(len <= k) {
+		rp[len] = rp[len-1].square();
+		powers_len[radix].store(++len, std::memory_order_release);
+	}
+
+	return rp[k];
+}
+
+
+// Write u into len characters of sp in radix, zero-padded on the left. u must be less than radix^len
+// Splits by cached radix powers into high and low digits, down to get_str_basecase()
+void LargeUnsignedInteger::get_str(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int radix) {
+	if(u.num_segments < DEC_DC_THRESHOLD  ||  u.num_segments < 2) {
+		get_str_basecase(sp, len, u, radix);
+		return;
+	}
+
+	// Largest cached power with at most half the words of u
+	unsigned int k = 0;
+	while(k+1 < RADIX_POWERS_MAX  &&  radix_power(radix, k+1).num_segments * 2 <= u.num_segments)
+		++k;
+
+	quot_rem qr = u.div_mod(radix_power(radix, k));
+
+	unsigned int low_len = RADIX_CHUNK_DIGITS[radix] << k;	// digits of remainder
+
+	get_str(sp, len - low_len, qr.first, radix);
+	get_str(sp + len - low_len, low_len, qr.second, radix);
+}
+
+
+// Write u into len characters of sp in radix, zero-padded on the left. u must be less than radix^len
+// Peels a word's worth of digits per single-word division, from the least-significant end
+void LargeUnsignedInteger::get_str_basecase(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int radix) {
+	constexpr unsigned int buf_len = 64;
+	ull_t buf[buf_len];
+	unsigned int n = u.num_segments;
+	ull_t* tp = n <= buf_len ? buf : new ull_t[n];
+
+	ull_t d = RADIX_CHUNK[radix];								// divisor
+	unsigned int chunk_digits = RADIX_CHUNK_DIGITS[radix];		// digits per division
+	unsigned int shift = __builtin_clzll(d);
+	ull_t v = invert_limb(d << shift);
+	ull_t chunk;												// remainder digits
+	char* cp = sp + len;										// next character, moving left
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		tp[i] = u.arr[i];
+	if(tp[n-1] == 0)
+		--n;
+
+	while(n > 0) {
+		chunk = div_1_preinv(tp, tp, n, d << shift, shift, v);
+		if(tp[n-1] == 0)
+			--n;
+
+		// Decimal digits divide by a constant
+		if(radix == 10)
+			for(unsigned int i = 0;  i < chunk_digits  &&  cp != sp;  ++i) {
+				*--cp = '0' + chunk % 10;
+				chunk /= 10;
+			}
+		else
+			for(unsigned int i = 0;  i < chunk_digits  &&  cp != sp;  ++i) {
+				*--cp = DIGIT_CHARS[chunk % radix];
+				chunk /= radix;
+			}
+	}
+
+	if(tp != buf)
+		delete[] tp;
+
+	// Pad with zeros
+	while(cp != sp)
+		*--cp = '0';
+}
+
+
+// Write u into len characters of sp in base 2^bits, zero-padded on the left. u must be less than 2^(len * bits)
+// Each digit is read straight from the words, from the least-significant end
+void LargeUnsignedInteger::get_str_pow2(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int bits) {
+	ull_t mask = (1ull << bits) - 1;
+	ull_t pos = 0;		// bit position of digit
+	unsigned int i;		// word of digit
+	unsigned int j;		// bit of digit in word
+	ull_t d;
+
+	for(char* cp = sp + len;  cp != sp;  pos += bits) {
+		i = pos / ULL_BITS;
+		j = pos % ULL_BITS;
+
+		d = i < u.num_segments ? u.arr[i] >> j : 0;
+		if(j + bits > ULL_BITS  &&  i+1 < u.num_segments)
+			d |= u.arr[i+1] << (ULL_BITS - j);
+
+		*--cp = DIGIT_CHARS[d & mask];
+	}
+}
+
+
+// Return an upper bound on the characters to_chars() writes in base, or 0 for a base outside 2 to 36
+// Exact for powers of two
+unsigned int LargeUnsignedInteger::max_chars(int base) const {
+	if(base < 2  ||  base > 36)
+		return 0;
+
+	unsigned int bits = bit_length();
+
+	if(bits == 0)
+		bits = 1;
+
+	if((base & (base-1)) == 0) {
+		unsigned int b = __builtin_ctz(base);
+		return (bits + b-1) / b;
+	}
+
+	// bits / log2(base), with a character of margin for rounding
+	return static_cast<unsigned int>(bits / std::log2(base)) + 2;
+}
+
+
+// Return digits in base as a string, without prefix or leading zeros
+// Throws for a base outside 2 to 36
+std::string LargeUnsignedInteger::to_string(int base) const {
+	unsigned int len = max_chars(base);
+
+	if(len == 0)
+		throw std::invalid_argument("Base must be from 2 to 36.");
+
+	std::string str(len, '0');
+	std::to_chars_result res = to_chars(&str[0], &str[0] + len, base);
+	str.resize(res.ptr - str.data());
+
+	return str;
+}
+
+
+// Write digits in base into [first, last), without prefix or leading zeros, as std::to_chars() does
+// Returns errc::value_too_large if the digits don't fit, or errc::invalid_argument for a base outside 2 to 36.
+// Doesn't allocate characters when last - first is at least max_chars(base)
+std::to_chars_result LargeUnsignedInteger::to_chars(char* first, char* last, int base) const {
+	unsigned int len = max_chars(base);
+	unsigned int avail = last - first;
+
+	if(len == 0)
+		return {first, std::errc::invalid_argument};
+
+	// Power-of-two digit counts are exact
+	if((base & (base-1)) == 0) {
+		if(avail < len)
+			return {last, std::errc::value_too_large};
+
+		get_str_pow2(first, len, *this, __builtin_ctz(base));
+		return {first + len, std::errc{}};
+	}
+
+	// Other digits are written zero-padded to the bound, then moved over leading zeros
+	char* sp = avail >= len ? first : new char[len];
+	get_str(sp, len, *this, base);
+
+	unsigned int start = 0;
+	while(start < len-1  &&  sp[start] == '0')
+		++start;
+
+	std::to_chars_result res{first + (len - start), std::errc{}};
+
+	if(len - start > avail)
+		res = {last, std::errc::value_too_large};
+	else
+		for(unsigned int i = start;  i < len;  ++i)
+			first[i - start] = sp[i];
+
+	if(sp != first)
+		delete[] sp;
+
+	return res;
+}
+
+
+// Set to the digits in base at the start of [first, last), as std::from_chars() does
+// Parses the longest run of digits, without prefix or separators, and returns a pointer past it.
+// Returns errc::invalid_argument and leaves this unchanged if there are no digits or base is outside 2 to 36
+std::from_chars_result LargeUnsignedInteger::from_chars(const char* first, const char* last, int base) {
+	if(base < 2  ||  base > 36)
+		return {first, std::errc::invalid_argument};
+
+	const char* sp = first;
+	while(sp != last  &&  digit_value(*sp) < base)
+		++sp;
+
+	if(sp == first)
+		return {first, std::errc::invalid_argument};
+
+	set_str_radix(first, sp - first, base);
+
+	return {sp, std::errc{}};
+}
+
+
+// Output stream
+// Digits are written by to_chars(), into a stack buffer for short numbers
+std::ostream& operator<<(std::ostream& os, const LargeUnsignedInteger& rhs) {
+	constexpr unsigned int buf_len = 256;
+	char buf[buf_len];
+	unsigned int len = rhs.max_chars(10);
+	char* sp = len <= buf_len ? buf : new char[len];
+
+	std::to_chars_result res = rhs.to_chars(sp, sp + len, 10);
+	os.write(sp, res.ptr - sp);
+
+	if(sp != buf)
+		delete[] sp;
+
+	return os;
+}
+
+
+// Input stream
+// Skips whitespace and reads digits in hex or oct if the stream is set to them, else decimal, up to the first
+// non-digit. A 0x or 0X prefix is taken in hex, as for built-in integers. Digits are taken from the stream buffer
+// in fixed-size blocks into LargeUnsignedDigitParser, so the text is never held whole. Sets failbit and zero if
+// there are no digits
+std::istream& operator>>(std::istream& is, LargeUnsignedInteger& rhs) {
+	std::istream::sentry sentry{is};
+	if(!sentry)
+		return is;
+
+	std::ios_base::fmtflags basefield = is.flags() & std::ios_base::basefield;
+	int base = basefield == std::ios_base::hex ? 16 : basefield == std::ios_base::oct ? 8 : 10;
+
+	constexpr unsigned int buf_len = 4096;
+	char buf[buf_len];
+	unsigned int n = 0;
+	LargeUnsignedDigitParser parser{base};
+	std::streambuf* sb = is.rdbuf();
+	std::ios_base::iostate state = std::ios_base::goodbit;
+
+	int c = sb->sgetc();
+
+	// Hex prefix. A lone 0 is a digit
+	if(base == 16  &&  c == '0') {
+		c = sb->snextc();
+		if(c == 'x'  ||  c == 'X')
+			c = sb->snextc();
+		else
+			buf[n++] = '0';
+	}
+
+	for(;  ;  c = sb->snextc()) {
+		if(c == std::char_traits<char>::eof()) {
+			state |= std::ios_base::eofbit;
+			break;
+		}
+		if(LargeUnsignedInteger::digit_value(c) >= base)
+			break;
+
+		buf[n++] = c;
+		if(n == buf_len) {
+			parser.push(buf, buf + n);
+			n = 0;
+		}
+	}
+	parser.push(buf, buf + n);
+
+	if(parser.empty()) {
+		rhs = 0;
+		state |= std::ios_base::failbit;
+	}
+	else
+		rhs = parser.finish();
+
+	is.setstate(state);
+	return is;
+}
+
+
+// Set to the digits in base read from file descriptor fd with read(), in fixed-size blocks up to end of file
+// Whitespace around the digits is skipped. Throws std::invalid_argument for other characters, no digits or
+// a base outside 2 to 36, and std::system_error if read() fails. Leaves this unchanged if it throws
+void LargeUnsignedInteger::read(int fd, int base) {
+	constexpr unsigned int buf_len = 16384;
+	char buf[buf_len];
+	ssize_t n;
+	LargeUnsignedDigitParser parser{base};
+	bool trailing = false;		// whitespace has followed the digits
+
+	while((n = ::read(fd, buf, buf_len)) != 0) {
+		if(n < 0) {
+			if(errno == EINTR)
+				continue;
+			throw std::system_error(errno, std::generic_category(), "read");
+		}
+
+		for(const char* sp = buf;  sp != buf + n;  ) {
+			if(std::isspace(static_cast<unsigned char>(*sp))) {
+				trailing = !parser.empty();
+				++sp;
+				continue;
+			}
+
+			const char* dp = trailing ? sp : parser.push(sp, buf + n);
+			if(dp == sp)
+				throw std::invalid_argument("Input contains invalid non-digit characters.");
+			sp = dp;
+		}
+	}
+
+	if(parser.empty())
+		throw std::invalid_argument("Input contains no digits.");
+
+	*this = parser.finish();
+}
+
+
+// Print object debugging info
+void LargeUnsignedInteger::print_debug(const std::string name) const {
+	std::cout << "LargeUnsignedInteger:   " << name << "\n";
+
+	std::cout << "Object Address:         " << this << "\n";
+
+	std::cout << "Array Address:          " << arr << "\n";
+
+	std::cout << "Array UINT Address:     " << arr_half << "\n";
+
+	std::cout << "Array Data (reversed):  [";
+	std::cout << std::hex;
+	for(unsigned int i = num_segments-1; i < num_segments; --i) {
+		std::cout << "0x";
+		std::cout << std::setw(16) << std::setfill('0');
+		std::cout << arr[i];
+		if(i > 0)
+			std::cout << ", ";
+	}
+	std::cout << "]\n";
+	std::cout << std::dec;
+
+	std::cout << "num_segments:           " << num_segments << "\n";
+
+	std::cout << "capacity:               " << capacity << "\n";
+
+	std::cout << std::endl;
+}
+
+
+// Return whether c is a digit separator
+bool LargeUnsignedInteger::is_separating_char(char c) {
+	return c == '\'' || c == ' ' || c == ',' || c == '.';
+}
+
+
+// Return value of digit character c in bases up to 36, or 0xFF if c isn't a digit
+unsigned char LargeUnsignedInteger::digit_value(char c) {
+	if(c >= '0'  &&  c <= '9')
+		return c - '0';
+	if(c >= 'a'  &&  c <= 'z')
+		return c - 'a' + 10;
+	if(c >= 'A'  &&  c <= 'Z')
+		return c - 'A' + 10;
+	return 0xFF;
+}
+
+
+// Binary string constructor
+void LargeUnsignedInteger::construct_string_bin(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
+	construct_string_radix(itr, itr_end, 2, "Binary string argument contains invalid non-binary characters.");
+}
+
+
+// Octal string constructor
+void LargeUnsignedInteger::construct_string_oct(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
+	construct_string_radix(itr, itr_end, 8, "Octal string argument contains invalid non-octal characters.");
+}
+
+
+// Decimal string constructor
+void LargeUnsignedInteger::construct_string_dec(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
+	construct_string_radix(itr, itr_end, 10, "Decimal string argument contains invalid non-decimal characters.");
+}
+
+
+// Hexadecimal string constructor
+void LargeUnsignedInteger::construct_string_hex(std::string::const_iterator& itr, std::string::const_iterator& itr_end) {
+	construct_string_radix(itr, itr_end, 16, "Hexadecimal string argument contains invalid non-hexadecimal characters.");
+}
+
+
+// String constructor for radix 2 to 36
+void LargeUnsignedInteger::construct_string_radix(std::string::const_iterator& itr, std::string::const_iterator& itr_end,
+		unsigned int radix, const char* err) {
+	// Skip empty digits
+	if(itr == itr_end)
+		return;
+
+	if(!set_str_radix(&*itr, itr_end - itr, radix))
+		throw std::invalid_argument(err);
+
+	itr = itr_end;
+}
+
+
+// Set to the value of len characters of sp in radix 2 to 36. Return false, leaving this unchanged,
+// if a character is neither a digit nor a separator. Digits are validated and stripped of separators by
+// strip_digits(), into a stack buffer for short strings
+bool LargeUnsignedInteger::set_str_radix(const char* sp, unsigned int len, unsigned int radix) {
+	constexpr unsigned int buf_len = 256;
+	char buf[buf_len];
+	char* dp = len <= buf_len ? buf : new char[len];	// digit values
+	unsigned int dn = 0;								// digits in dp
+
+	bool valid = strip_digits(dp, dn, sp, len, radix);
+
+	if(valid) {
+		if((radix & (radix-1)) == 0)
+			set_str_pow2(dp, dn, __builtin_ctz(radix));
+		else
+			set_str(dp, dn, radix);
+	}
+
+	if(dp != buf)
+		delete[] dp;
+
+	return valid;
+}
+
+
+// Set to the value of len digit values of sp in radix, most-significant first
+// Splits into high and low digits at cached radix powers, down to set_str_basecase()
+void LargeUnsignedInteger::set_str(const char* sp, unsigned int len, unsigned int radix) {
+	unsigned int chunk_digits = RADIX_CHUNK_DIGITS[radix];	// digits per word
+
+	if(len / chunk_digits < DEC_DC_THRESHOLD  ||  len <= 2 * chunk_digits) {
+		set_str_basecase(sp, len, radix);
+		return;
+	}
+
+	// Largest cached power with fewer digits than sp, so the high digits are no longer than the low digits
+	unsigned int k = 0;
+	while(k+1 < RADIX_POWERS_MAX  &&  (chunk_digits << (k+1)) < len)
+		++k;
+
+	unsigned int low_len = chunk_digits << k;	// digits of low part
+
+	// high * radix^low_len + low
+	LargeUnsignedInteger high;
+	high.set_str(sp, len - low_len, radix);
+
+	set_str(sp + len - low_len, low_len, radix);
+	addmul(high, radix_power(radix, k));
+}
+
+
+// Set to the value of len digit values of sp in radix, most-significant first
+// Takes a word's worth of digits per single-word multiply and add
+void LargeUnsignedInteger::set_str_basecase(const char* sp, unsigned int len, unsigned int radix) {
+	ull_t d = RADIX_CHUNK[radix];							// multiplier per chunk
+	unsigned int chunk_digits = RADIX_CHUNK_DIGITS[radix];	// digits per word
+
+	resize(len / chunk_digits + 1);
+	for(unsigned int i = 0;  i < num_segments;  ++i)
+		arr[i] = 0;
+
+	unsigned int rn = 1;								// words in use
+	unsigned int chunk_len = len % chunk_digits;		// digits of leading chunk
+	const char* sp_end = sp + len;
+	ull_t chunk;										// chunk value
+	ull_t carry;
+
+	if(chunk_len == 0)
+		chunk_len = chunk_digits;
+
+	for(;  sp != sp_end;  sp += chunk_len, chunk_len = chunk_digits) {
+		if(radix == 10  &&  chunk_len == DEC_CHUNK_DIGITS)
+			chunk = dec_chunk_value(sp);
+		else {
+			chunk = 0;
+			for(unsigned int i = 0;  i < chunk_len;  ++i)
+				chunk = chunk * radix + sp[i];
+		}
+
+		// Shift in chunk
+		carry = mul_1(arr, arr, rn, d);
+		carry += add_1(arr, arr, rn, chunk);
+		if(carry)
+			arr[rn++] = carry;
+	}
+
+	trim();
+}
+
+
+// Set to the value of len digit values of sp in base 2^bits, most-significant first
+// Packs digits into words from the least-significant end, carrying digit bits that straddle words
+void LargeUnsignedInteger::set_str_pow2(const char* sp, unsigned int len, unsigned int bits) {
+	resize(MAX(((ull_t)len * bits + ULL_BITS-1) / ULL_BITS, 1));
+	arr[0] = 0;
+
+	ull_t limb = 0;				// word being filled
+	unsigned int limb_bits = 0;	// bits filled in limb
+	unsigned int i = 0;			// index of limb
+	ull_t d;
+
+	// Reverse-iterate through digits
+	for(const char* dp = sp + len;  dp != sp;  ) {
+		d = *--dp;
+		limb |= d << limb_bits;
+		limb_bits += bits;
+
+		// Store full word
+		if(limb_bits >= ULL_BITS) {
+			arr[i++] = limb;
+			limb_bits -= ULL_BITS;
+			limb = limb_bits ? d >> (bits - limb_bits) : 0;
+		}
+	}
+
+	if(limb_bits)
+		arr[i] = limb;
+
+	trim();
+}
+
+
+// Copy the digit values of len characters of sp into dp, skipping separating characters, and add their count to dn
+// Return false if a character is neither a digit less than radix nor a separator. Vectorized where available
+bool LargeUnsignedInteger::strip_digits(char* dp, unsigned int& dn, const char* sp, unsigned int len, unsigned int radix) {
+	unsigned int i = 0;		// characters done
+	unsigned char d;
+
+#if defined(__x86_64__)
+	static const bool has_avx2 = __builtin_cpu_supports("avx2");
+
+	// 32-character blocks, then 16-character blocks
+	if(has_avx2  &&  !strip_digits_avx2(dp, dn, sp, i, len, radix))
+		return false;
+	if(!strip_digits_sse2(dp, dn, sp, i, len, radix))
+		return false;
+#endif
+
+	// Remaining characters
+	for(;  i < len;  ++i) {
+		if(!is_separating_char(sp[i])) {
+			d = digit_value(sp[i]);
+			if(d >= radix)
+				return false;
+			dp[dn++] = d;
+		}
+	}
+
+	return true;
+}
+
+
+#if defined(__x86_64__)
+// strip_digits() for blocks of 16 characters, advancing i past them
+// Blocks without separators are stored whole. Blocks with separators are compacted by mask
+bool LargeUnsignedInteger::strip_digits_sse2(char* dp, unsigned int& dn, const char* sp, unsigned int& i, unsigned int len, unsigned int radix) {
+	const __m128i dig_max = _mm_set1_epi8((radix < 10 ? radix : 10) - 1);
+	const __m128i let_max = _mm_set1_epi8(radix > 10 ? radix - 11 : 0);
+	alignas(16) char vals[16];
+
+	for(;  i + 16 <= len;  i += 16) {
+		__m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp + i));
+
+		// Digits 0-9, as unsigned c - '0' <= dig_max
+		__m128i v = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+		__m128i is_dig = _mm_cmpeq_epi8(_mm_min_epu8(v, dig_max), v);
+		v = _mm_and_si128(v, is_dig);
+
+		// Letters of either case, as unsigned (c | 0x20) - 'a' <= let_max
+		if(radix > 10) {
+			__m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+			__m128i is_let = _mm_cmpeq_epi8(_mm_min_epu8(l, let_max), l);
+			v = _mm_or_si128(v, _mm_and_si128(_mm_add_epi8(l, _mm_set1_epi8(10)), is_let));
+			is_dig = _mm_or_si128(is_dig, is_let);
+		}
+
+		__m128i is_sep = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\'')), _mm_cmpeq_epi8(c, _mm_set1_epi8(' '))),
+				_mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(',')), _mm_cmpeq_epi8(c, _mm_set1_epi8('.'))));
+
+		unsigned int dig_mask = _mm_movemask_epi8(is_dig);
+		unsigned int sep_mask = _mm_movemask_epi8(is_sep);
+
+		if((dig_mask | sep_mask) != 0xFFFF)
+			return false;
+
+		if(sep_mask == 0) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dp + dn), v);
+			dn += 16;
+		}
+		else {
+			_mm_store_si128(reinterpret_cast<__m128i*>(vals), v);
+			for(unsigned int j = 0;  j < 16;  ++j)
+				if((dig_mask >> j) & 1)
+					dp[dn++] = vals[j];
+		}
+	}
+
+	return true;
+}
+
+
+// strip_digits() for blocks of 32 characters, advancing i past them
+__attribute__((target("avx2")))
+bool LargeUnsignedInteger::strip_digits_avx2(char* dp, unsigned int& dn, const char* sp, unsigned int& i, unsigned int len, unsigned int radix) {
+	const __m256i dig_max = _mm256_set1_epi8((radix < 10 ? radix : 10) - 1);
+	const __m256i let_max = _mm256_set1_epi8(radix > 10 ? radix - 11 : 0);
+	alignas(32) char vals[32];
+
+	for(;  i + 32 <= len;  i += 32) {
+		__m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sp + i));
+
+		// Digits 0-9
+		__m256i v = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+		__m256i is_dig = _mm256_cmpeq_epi8(_mm256_min_epu8(v, dig_max), v);
+		v = _mm256_and_si256(v, is_dig);
+
+		// Letters of either case
+		if(radix > 10) {
+			__m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+			__m256i is_let = _mm256_cmpeq_epi8(_mm256_min_epu8(l, let_max), l);
+			v = _mm256_or_si256(v, _mm256_and_si256(_mm256_add_epi8(l, _mm256_set1_epi8(10)), is_let));
+			is_dig = _mm256_or_si256(is_dig, is_let);
+		}
+
+		__m256i is_sep = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\'')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' '))),
+				_mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(c, _mm256_set1_epi8('.'))));
+
+		unsigned int dig_mask = _mm256_movemask_epi8(is_dig);
+		unsigned int sep_mask = _mm256_movemask_epi8(is_sep);
+
+		if((dig_mask | sep_mask) != 0xFFFF'FFFFu)
+			return false;
+
+		if(sep_mask == 0) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dp + dn), v);
+			dn += 32;
+		}
+		else {
+			_mm256_store_si256(reinterpret_cast<__m256i*>(vals), v);
+			for(unsigned int j = 0;  j < 32;  ++j)
+				if((dig_mask >> j) & 1)
+					dp[dn++] = vals[j];
+		}
+	}
+
+	return true;
+}
+#endif
+
+
+// Return the value of DEC_CHUNK_DIGITS decimal digit values of sp, most-significant first
+ull_t LargeUnsignedInteger::dec_chunk_value(const char* sp) {
+#if defined(__x86_64__)
+	static const bool has_sse41 = __builtin_cpu_supports("sse4.1");
+
+	if(has_sse41)
+		return dec_chunk_value_sse41(sp);
+#endif
+
+	ull_t chunk = 0;
+	for(unsigned int i = 0;  i < DEC_CHUNK_DIGITS;  ++i)
+		chunk = chunk * 10 + sp[i];
+
+	return chunk;
+}
+
+
+#if defined(__x86_64__)
+// dec_chunk_value() combining the first 16 digits pairwise: into 2-digit, 4-digit, then 8-digit lanes
+__attribute__((target("sse4.1")))
+ull_t LargeUnsignedInteger::dec_chunk_value_sse41(const char* sp) {
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sp));
+	v = _mm_maddubs_epi16(v, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+	v = _mm_madd_epi16(v, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+	v = _mm_packus_epi32(v, v);
+	v = _mm_madd_epi16(v, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+
+	ull_t hi = static_cast<unsigned int>(_mm_cvtsi128_si32(v));		// digits 0-7
+	ull_t lo = static_cast<unsigned int>(_mm_extract_epi32(v, 1));	// digits 8-15
+
+	return (hi * 100'000'000 + lo) * 1000 + sp[16] * 100 + sp[17] * 10 + sp[18];
+}
+#endif
+
+
+// Reassign arr to new pointer, and refress arr_half
+void LargeUnsignedInteger::assign_arr(ull_t* arr_new) {
+	// Delete existing array
+	delete[] arr;
+
+	// Assign new array
+	arr = arr_new;
+
+	// Refresh arr_half
+	refresh_arr_half();
+}
+
+
+// Refresh arr_half to reference arr
+void LargeUnsignedInteger::refresh_arr_half() {
+	arr_half = reinterpret_cast<unsigned int*>(arr);
+}
+
+
+// Grow capacity to at least len words, keeping the current value
+void LargeUnsignedInteger::reserve(unsigned int len) {
+	// Skip if capacity is sufficient
+	if(len > capacity) {
+		ull_t* new_arr = new ull_t[len];
+
+		// Copy old array to new array
+		for(unsigned int i = 0;  i < num_segments;  ++i)
+			new_arr[i] = arr[i];
+
+		// Reset members
+		assign_arr(new_arr);
+		capacity = len;
+	}
+}
+
+
+// Resize. Only reallocates when growing past capacity
+void LargeUnsignedInteger::resize(unsigned int len) {
+	// Grow array if needed
+	reserve(len);
+
+	// Fill added elements with zeros
+	for(unsigned int i = num_segments;  i < len;  ++i)
+		arr[i] = 0;
+
+	num_segments = len;
+}
+
+
+// Resize to minimum needed words
+void LargeUnsignedInteger::trim() {
+	// Get minimum needed words
+	unsigned int min_segments = num_segments;
+	while(arr[--min_segments] == 0ull && min_segments > 0);
+
+	// Resize
+	resize(MAX(min_segments+1, 1));
+}
+
+
+// Multiply n words of up by v into rp. Return carry-out word
+// rp may be equal to up
+ull_t LargeUnsignedInteger::mul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v) {
+	u128_t prod;		// full double-word product
+	ull_t carry = 0;	// carry word
+
+	// Iterate through words
+	for(unsigned int i = 0;  i < n;  ++i) {
+		prod = static_cast<u128_t>(up[i]) * v + carry;
+		rp[i] = static_cast<ull_t>(prod);
+		carry = static_cast<ull_t>(prod >> ULL_BITS);
+	}
+
+	return carry;
+}
+
+
+// Multiply n words of up by v and accumulate into rp. Return carry-out word
+ull_t LargeUnsignedInteger::addmul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v) {
+	u128_t prod;		// full double-word product
+	ull_t carry = 0;	// carry word
+
+	// Iterate through words
+	for(unsigned int i = 0;  i < n;  ++i) {
+		prod = static_cast<u128_t>(up[i]) * v + rp[i] + carry;
+		rp[i] = static_cast<ull_t>(prod);
+		carry = static_cast<ull_t>(prod >> ULL_BITS);
+	}
+
+	return carry;
+}
+
+
+// Schoolbook multiplication of un words of up by vn words of vp into un+vn words of rp
+// rp must not overlap either operand
+void LargeUnsignedInteger::mul_basecase(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	// First row sets the product
+	rp[un] = mul_1(rp, up, un, vp[0]);
+
+	// Accumulate one row per remaining word of vp, storing the carry-out as the next high word
+	for(unsigned int j = 1;  j < vn;  ++j)
+		rp[un+j] = addmul_1(rp+j, up, un, vp[j]);
+}
+
+
+
+// Add n words of up and vp into rp. Return carry-out
+// rp may be equal to up or vp
+ull_t LargeUnsignedInteger::add_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n) {
+	ull_t half_sum;		// half adder sum
+	ull_t carry = 0;	// adder carry bit
+
+	for(unsigned int i = 0;  i < n;  ++i) {
+		half_sum = up[i] + carry;
+		carry = half_sum < carry;
+		rp[i] = half_sum + vp[i];
+		carry += rp[i] < half_sum;
+	}
+
+	return carry;
+}
+
+
+// Subtract n words of vp from up into rp. Return borrow-out
+// rp may be equal to up or vp
+ull_t LargeUnsignedInteger::sub_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n) {
+	ull_t u, v;			// operand words, read before rp is written
+	ull_t half_diff;	// half subtracter difference
+	ull_t borrow = 0;	// subtracter borrow bit
+
+	for(unsigned int i = 0;  i < n;  ++i) {
+		u = up[i];
+		v = vp[i];
+		half_diff = u - v;
+		rp[i] = half_diff - borrow;
+		borrow = (u < v) | (half_diff < borrow);
+	}
+
+	return borrow;
+}
+
+
+// Add word v to n words of up into rp. Return carry-out
+// rp may be equal to up. In place, stops at the first word the carry doesn't overflow
+ull_t LargeUnsignedInteger::add_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v) {
+	unsigned int i = 0;
+
+	for(;  i < n  &&  v;  ++i) {
+		rp[i] = up[i] + v;
+		v = rp[i] < v;
+	}
+
+	// Copy the rest
+	if(rp != up)
+		for(;  i < n;  ++i)
+			rp[i] = up[i];
+
+	return v;
+}
+
+
+// Subtract word v from n words of up into rp. Return borrow-out
+// rp may be equal to up. In place, stops at the first word the borrow doesn't underflow
+ull_t LargeUnsignedInteger::sub_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v) {
+	unsigned int i = 0;
+	ull_t borrow;
+
+	for(;  i < n  &&  v;  ++i) {
+		borrow = up[i] < v;
+		rp[i] = up[i] - v;
+		v = borrow;
+	}
+
+	// Copy the rest
+	if(rp != up)
+		for(;  i < n;  ++i)
+			rp[i] = up[i];
+
+	return v;
+}
+
+
+// Add vn words of vp to un words of up into rp, where un >= vn. Return carry-out
+// rp may be equal to up
+ull_t LargeUnsignedInteger::add(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	ull_t carry = add_n(rp, up, vp, vn);
+	return add_1(rp+vn, up+vn, un-vn, carry);
+}
+
+
+// Subtract vn words of vp from un words of up into rp, where un >= vn. Return borrow-out
+// rp may be equal to up
+ull_t LargeUnsignedInteger::sub(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	ull_t borrow = sub_n(rp, up, vp, vn);
+	return sub_1(rp+vn, up+vn, un-vn, borrow);
+}
+
+
+// Compare n words of up and vp. Return -1, 0 or 1
+int LargeUnsignedInteger::cmp_n(const ull_t* up, const ull_t* vp, unsigned int n) {
+	// Reverse-iterate through words
+	for(unsigned int i = n-1;  i < n;  --i) {
+		if(up[i] != vp[i])
+			return up[i] < vp[i] ? -1 : 1;
+	}
+
+	return 0;
+}
+
+
+// Store |u - v| of un words of up and vn words of vp into un words of rp, where un >= vn
+// Return true if u < v
+bool LargeUnsignedInteger::abs_diff(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	// Check high words of u that v does not have
+	bool u_high = false;
+	for(unsigned int i = vn;  i < un;  ++i)
+		u_high = u_high || up[i] != 0;
+
+	// u >= v
+	if(u_high || cmp_n(up, vp, vn) >= 0) {
+		sub(rp, up, un, vp, vn);
+		return false;
+	}
+
+	// u < v, so high words of u are all zero
+	sub_n(rp, vp, up, vn);
+	for(unsigned int i = vn;  i < un;  ++i)
+		rp[i] = 0;
+
+	return true;
+}
+
+
+// Multiply n words of up by v and subtract from rp. Return borrow-out word
+ull_t LargeUnsignedInteger::submul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v) {
+	u128_t prod;		// full double-word product
+	ull_t prod_low;		// low word of product plus borrow
+	ull_t borrow = 0;	// borrow word
+
+	// Iterate through words
+	for(unsigned int i = 0;  i < n;  ++i) {
+		prod = static_cast<u128_t>(up[i]) * v + borrow;
+		prod_low = static_cast<ull_t>(prod);
+		borrow = static_cast<ull_t>(prod >> ULL_BITS) + (rp[i] < prod_low);
+		rp[i] -= prod_low;
+	}
+
+	return borrow;
+}
+
+
+// Store the two's complement negation of n words of up into rp
+// rp may be equal to up
+void LargeUnsignedInteger::neg_n(ull_t* rp, const ull_t* up, unsigned int n) {
+	ull_t carry = 1;
+
+	for(unsigned int i = 0;  i < n;  ++i) {
+		rp[i] = ~up[i] + carry;
+		carry = carry && rp[i] == 0;
+	}
+}
+
+
+// Right-shift n words of up by cnt bits into rp, where 0 < cnt < ULL_BITS. Return bits shifted out, left-aligned
+// rp may be equal to up
+ull_t LargeUnsignedInteger::rshift(ull_t* rp, const ull_t* up, unsigned int n, unsigned int cnt) {
+	ull_t out = up[0] << (ULL_BITS - cnt);
+
+	for(unsigned int i = 0;  i < n-1;  ++i)
+		rp[i] = (up[i] >> cnt) | (up[i+1] << (ULL_BITS - cnt));
+	rp[n-1] = up[n-1] >> cnt;
+
+	return out;
+}
+
+
+// Left-shift n words of up by cnt bits into rp, where 0 < cnt < ULL_BITS. Return bits shifted out, right-aligned
+// rp may be equal to up
+ull_t LargeUnsignedInteger::lshift(ull_t* rp, const ull_t* up, unsigned int n, unsigned int cnt) {
+	ull_t out = up[n-1] >> (ULL_BITS - cnt);
+
+	for(unsigned int i = n-1;  i > 0;  --i)
+		rp[i] = (up[i] << cnt) | (up[i-1] >> (ULL_BITS - cnt));
+	rp[0] = up[0] << cnt;
+
+	return out;
+}
+
+
+// Divide n words of up by odd word d into rp, where the division is known to be exact
+// Works modulo 2^(n*ULL_BITS), so two's complement values divide correctly
+// rp may be equal to up
+void LargeUnsignedInteger::divexact_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t d) {
+	// Inverse of d modulo 2^64 by Newton iteration. d*d = 1 (mod 8) gives the first 3 bits
+	ull_t inv = d;
+	for(unsigned int i = 0;  i < 5;  ++i)
+		inv *= 2 - d * inv;
+
+	ull_t u, s, q;
+	ull_t borrow = 0;
+
+	// Iterate through words
+	for(unsigned int i = 0;  i < n;  ++i) {
+		u = up[i];
+		s = u - borrow;
+		q = s * inv;
+		rp[i] = q;
+		borrow = static_cast<ull_t>((static_cast<u128_t>(q) * d) >> ULL_BITS) + (u < borrow);
+	}
+}
+
+
+// Multiply un words of up by vn words of vp into un+vn words of rp
+// rp must not overlap either operand
+void LargeUnsignedInteger::mul(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	unsigned int sn = mul_scratch_size(un, vn);
+	ull_t* scratch = sn ? new ull_t[sn] : nullptr;
+
+	mul(rp, up, un, vp, vn, scratch);
+
+	delete[] scratch;
+}
+
+
+// Multiply un words of up by vn words of vp into un+vn words of rp, using scratch from mul_scratch_size()
+// rp must not overlap either operand or scratch
+void LargeUnsignedInteger::mul(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn, ull_t* scratch) {
+	// Make up the longer operand
+	if(un < vn) {
+		std::swap(up, vp);
+		std::swap(un, vn);
+	}
+
+	// Operands are the same number
+	if(up == vp && un == vn) {
+		sqr_n(rp, up, un, scratch);
+		return;
+	}
+
+	// Multiplier is too short for subquadratic methods
+	if(vn < KARATSUBA_THRESHOLD) {
+		mul_basecase(rp, up, un, vp, vn);
+		return;
+	}
+
+	// Multiplier is long enough for the NTT, which handles unbalanced operands directly
+	if(vn >= FFT_THRESHOLD) {
+		mul_fft(rp, up, un, vp, vn);
+		return;
+	}
+
+	// Balanced operands
+	if(un == vn) {
+		mul_n(rp, up, vp, vn, scratch);
+		return;
+	}
+
+	// Unbalanced Toom for up to 2.5 times the length of vp
+	unsigned int ku = mul_toom_parts(un, vn);	// number of parts of up. vp is split in two
+	if(ku > 0) {
+		mul_toom(rp, up, un, vp, vn, ku, 2, scratch);
+		return;
+	}
+
+	// Split up into chunks of vn words, or 2*vn words when Toom-42 applies
+	unsigned int chunk = (vn >= TOOM42_THRESHOLD && un >= 2*vn) ? 2*vn : vn;
+
+	// Scratch holds the chunk product, then scratch for the recursion
+	ull_t* prod = scratch;
+	ull_t* prod_scratch = scratch + chunk + vn;
+
+	ull_t carry;
+	unsigned int i = 0;
+
+	// Multiply whole chunks of up, and accumulate over the high words of the previous chunk
+	for(;  i + chunk <= un;  i += chunk) {
+		ull_t* dst = (i == 0) ? rp : prod;
+
+		if(chunk == vn)
+			mul_n(dst, up+i, vp, vn, prod_scratch);
+		else
+			mul_toom(dst, up+i, chunk, vp, vn, 4, 2, prod_scratch);
+
+		if(i > 0) {
+			carry = add_n(rp+i, rp+i, prod, vn);
+			add_1(rp+i+vn, prod+vn, chunk, carry);
+		}
+	}
+
+	// Multiply remaining partial chunk of up and accumulate
+	if(i < un) {
+		mul(prod, vp, vn, up+i, un-i, prod_scratch);
+		carry = add_n(rp+i, rp+i, prod, vn);
+		add_1(rp+i+vn, prod+vn, un-i, carry);
+	}
+}
+
+
+// Return number of parts of up for unbalanced Toom with vp split in two, or 0 to multiply by chunks
+// un must be greater than vn
+unsigned int LargeUnsignedInteger::mul_toom_parts(unsigned int un, unsigned int vn) {
+	// Up to 2.5 times the length of vp
+	if(2*un >= 5*vn)
+		return 0;
+
+	if(vn >= TOOM42_THRESHOLD && 4*un >= 7*vn)
+		return 4;
+	if(vn >= TOOM32_THRESHOLD && 4*un >= 5*vn)
+		return 3;
+	return 0;
+}
+
+
+// Return number of scratch words needed by mul() with scratch, for un-word and vn-word operands
+unsigned int LargeUnsignedInteger::mul_scratch_size(unsigned int un, unsigned int vn) {
+	if(un < vn)
+		std::swap(un, vn);
+
+	// Basecase and NTT need no scratch
+	if(vn < KARATSUBA_THRESHOLD  ||  vn >= FFT_THRESHOLD)
+		return 0;
+
+	if(un == vn)
+		return mul_n_scratch_size(vn);
+
+	unsigned int ku = mul_toom_parts(un, vn);
+	if(ku > 0)
+		return mul_toom_scratch_size(un, vn, ku, 2);
+
+	// Chunk product, then the larger of the chunk and remainder products' scratch
+	unsigned int chunk = (vn >= TOOM42_THRESHOLD && un >= 2*vn) ? 2*vn : vn;
+	unsigned int prod_scratch_len = (chunk == vn) ? mul_n_scratch_size(vn) : mul_toom_scratch_size(chunk, vn, 4, 2);
+	unsigned int rem_scratch_len = (un % chunk) ? mul_scratch_size(vn, un % chunk) : 0;
+
+	return chunk + vn + (prod_scratch_len > rem_scratch_len ? prod_scratch_len : rem_scratch_len);
+}
+
+
+// Multiply n words of up by n words of vp into 2n words of rp, using scratch from mul_n_scratch_size()
+// rp must not overlap either operand or scratch
+void LargeUnsignedInteger::mul_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n, ull_t* scratch) {
+	if(up == vp)
+		sqr_n(rp, up, n, scratch);
+	else if(n < KARATSUBA_THRESHOLD || n < 4)
+		mul_basecase(rp, up, n, vp, n);
+	else if(n >= FFT_THRESHOLD)
+		mul_fft(rp, up, n, vp, n);
+	else if(n >= TOOM44_THRESHOLD && n >= TOOM_MIN_SIZE)
+		mul_toom(rp, up, n, vp, n, 4, 4, scratch);
+	else if(n >= TOOM33_THRESHOLD && n >= TOOM_MIN_SIZE)
+		mul_toom(rp, up, n, vp, n, 3, 3, scratch);
+	else
+		mul_karatsuba(rp, up, vp, n, scratch);
+}
+
+
+// Return number of scratch words needed by mul_n() for n-word operands
+// The NTT allocates its own buffers. This bounds every other tier: Karatsuba needs at most 8n words, and Toom-3 / Toom-4 at most 12n words from TOOM_MIN_SIZE up
+unsigned int LargeUnsignedInteger::mul_n_scratch_size(unsigned int n) {
+	// Basecase needs no scratch
+	if(n < KARATSUBA_THRESHOLD || n < 4)
+		return 0;
+
+	return 12*n;
+}
+
+
+// Karatsuba multiplication of n words of up by n words of vp into 2n words of rp
+// Splits operands into low m words and high n-m words, and forms three half-size products:
+// a0*b0, a1*b1 and |a0-a1|*|b0-b1|
+void LargeUnsignedInteger::mul_karatsuba(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n, ull_t* scratch) {
+	unsigned int m = n - n/2;	// low-part length
+	unsigned int h = n/2;		// high-part length
+
+	ull_t* da = scratch;			// |a0 - a1|
+	ull_t* db = scratch + m;		// |b0 - b1|
+	ull_t* zm = scratch + 2*m;		// |a0 - a1| * |b0 - b1|
+	ull_t* t = scratch + 4*m;		// middle sum, and scratch for recursion
+
+	// Form differences, tracking the sign of their product
+	bool neg = abs_diff(da, up, m, up+m, h) != abs_diff(db, vp, m, vp+m, h);
+
+	// Recursive products
+	mul_n(rp, up, vp, m, t);			// a0*b0 into low 2m words
+	mul_n(rp+2*m, up+m, vp+m, h, t);	// a1*b1 into high 2h words
+	mul_n(zm, da, db, m, t);
+
+	// Middle term: a0*b0 + a1*b1 - (a0-a1)*(b0-b1)
+	t[2*m] = add(t, rp, 2*m, rp+2*m, 2*h);
+	if(neg)
+		t[2*m] += add_n(t, t, zm, 2*m);
+	else
+		t[2*m] -= sub_n(t, t, zm, 2*m);
+
+	// Accumulate middle term at offset m
+	add(rp+m, rp+m, 2*n-m, t, 2*m+1);
+}
+
+
+// Square n words of up into 2n words of rp
+// rp must not overlap up
+void LargeUnsignedInteger::sqr(ull_t* rp, const ull_t* up, unsigned int n) {
+	// Basecase and NTT need no scratch
+	if(n < KARATSUBA_THRESHOLD || n < 4 || n >= FFT_THRESHOLD) {
+		sqr_n(rp, up, n, nullptr);
+		return;
+	}
+
+	ull_t* scratch = new ull_t[mul_n_scratch_size(n)];
+	sqr_n(rp, up, n, scratch);
+	delete[] scratch;
+}
+
+
+// Square n words of up into 2n words of rp, using scratch from mul_n_scratch_size()
+// rp must not overlap up or scratch
+void LargeUnsignedInteger::sqr_n(ull_t* rp, const ull_t* up, unsigned int n, ull_t* scratch) {
+	if(n < KARATSUBA_THRESHOLD || n < 4)
+		sqr_basecase(rp, up, n);
+	else if(n >= FFT_THRESHOLD)
+		mul_fft(rp, up, n, up, n);
+	else if(n >= TOOM44_THRESHOLD && n >= TOOM_MIN_SIZE)
+		mul_toom(rp, up, n, up, n, 4, 4, scratch);
+	else if(n >= TOOM33_THRESHOLD && n >= TOOM_MIN_SIZE)
+		mul_toom(rp, up, n, up, n, 3, 3, scratch);
+	else
+		sqr_karatsuba(rp, up, n, scratch);
+}
+
+
+// Schoolbook squaring of n words of up into 2n words of rp
+// Each cross product u_i * u_j is formed once and doubled, then the squares u_i^2 are added
+// rp must not overlap up
+void LargeUnsignedInteger::sqr_basecase(ull_t* rp, const ull_t* up, unsigned int n) {
+	// Clear product
+	for(unsigned int i = 0;  i < 2*n;  ++i)
+		rp[i] = 0;
+
+	// Accumulate cross products above the diagonal, one row per word
+	for(unsigned int i = 0;  i + 1 < n;  ++i)
+		rp[i+n] = addmul_1(rp + 2*i+1, up+i+1, n-i-1, up[i]);
+
+	// Double cross products
+	lshift(rp, rp, 2*n, 1);
+
+	u128_t sq;			// square of word
+	u128_t sum;			// double-word sum
+	ull_t carry = 0;	// carry word
+
+	// Add squares on the diagonal
+	for(unsigned int i = 0;  i < n;  ++i) {
+		sq = static_cast<u128_t>(up[i]) * up[i];
+
+		sum = static_cast<u128_t>(rp[2*i]) + static_cast<ull_t>(sq) + carry;
+		rp[2*i] = static_cast<ull_t>(sum);
+
+		sum = static_cast<u128_t>(rp[2*i+1]) + static_cast<ull_t>(sq >> ULL_BITS) + static_cast<ull_t>(sum >> ULL_BITS);
+		rp[2*i+1] = static_cast<ull_t>(sum);
+
+		carry = static_cast<ull_t>(sum >> ULL_BITS);
+	}
+}
+
+
+// Karatsuba squaring of n words of up into 2n words of rp
+// The middle product |a0-a1|^2 is never negative, so the middle term is always a0^2 + a1^2 - (a0-a1)^2
+void LargeUnsignedInteger::sqr_karatsuba(ull_t* rp, const ull_t* up, unsigned int n, ull_t* scratch) {
+	unsigned int m = n - n/2;	// low-part length
+	unsigned int h = n/2;		// high-part length
+
+	ull_t* da = scratch;			// |a0 - a1|
+	ull_t* zm = scratch + m;		// (a0 - a1)^2
+	ull_t* t = scratch + 3*m;		// middle sum, and scratch for recursion
+
+	abs_diff(da, up, m, up+m, h);
+
+	// Recursive squares
+	sqr_n(rp, up, m, t);			// a0^2 into low 2m words
+	sqr_n(rp+2*m, up+m, h, t);		// a1^2 into high 2h words
+	sqr_n(zm, da, m, t);
+
+	// Middle term
+	t[2*m] = add(t, rp, 2*m, rp+2*m, 2*h);
+	t[2*m] -= sub_n(t, t, zm, 2*m);
+
+	// Accumulate middle term at offset m
+	add(rp+m, rp+m, 2*n-m, t, 2*m+1);
+}
+
+
+// Return the Toom part length for splitting un words into ku parts and vn words into kv parts
+unsigned int LargeUnsignedInteger::toom_part_size(unsigned int un, unsigned int vn, unsigned int ku, unsigned int kv) {
+	unsigned int ku_len = (un + ku - 1) / ku;
+	unsigned int kv_len = (vn + kv - 1) / kv;
+	return ku_len > kv_len ? ku_len : kv_len;
+}
+
+
+// Return the i-th finite Toom evaluation point: 0, 1, -1, 2, -2, 3, ...
+long long LargeUnsignedInteger::toom_point(unsigned int i) {
+	return (i % 2 == 1) ? static_cast<long long>((i+1) / 2) : -static_cast<long long>(i / 2);
+}
+
+
+// Return number of scratch words needed by mul_toom()
+unsigned int LargeUnsignedInteger::mul_toom_scratch_size(unsigned int un, unsigned int vn, unsigned int ku, unsigned int kv) {
+	unsigned int k = toom_part_size(un, vn, ku, kv);
+	unsigned int d = ku + kv - 2;
+
+	// Point values, even / odd parts and |u(x)| / |v(x)|, then the recursion
+	return (d+1) * (2*k+2) + 6 * (k+1) + mul_n_scratch_size(k+1);
+}
+
+
+// Evaluate the even and odd parts of a polynomial with kp coefficients of k words (the top one s words)
+// at x = j, into k+1 words each of ep and op
+void LargeUnsignedInteger::toom_eval(ull_t* ep, ull_t* op, const ull_t* up, unsigned int kp, unsigned int k, unsigned int s, ull_t j) {
+	ull_t* dst;
+	unsigned int len;
+	ull_t carry;
+	ull_t pow_j = 1;	// j^i
+
+	// Clear parts
+	for(unsigned int i = 0;  i <= k;  ++i) {
+		ep[i] = 0;
+		op[i] = 0;
+	}
+
+	// Accumulate coefficients times j^i
+	for(unsigned int i = 0;  i < kp;  ++i) {
+		dst = (i % 2 == 0) ? ep : op;
+		len = (i < kp-1) ? k : s;
+
+		carry = addmul_1(dst, up + i*k, len, pow_j);
+		add_1(dst+len, dst+len, k+1-len, carry);
+
+		pow_j *= j;
+	}
+}
+
+
+// Exactly divide two's complement value of n words in wp by a small non-zero integer
+void LargeUnsignedInteger::toom_divexact(ull_t* wp, unsigned int n, long long d) {
+	ull_t d_abs = d < 0 ? -d : d;
+	unsigned int tz = __builtin_ctzll(d_abs);
+
+	// Arithmetic right-shift out the power of two
+	if(tz > 0) {
+		bool neg = wp[n-1] >> (ULL_BITS-1);
+		rshift(wp, wp, n, tz);
+		if(neg)
+			wp[n-1] |= ULL_MAX << (ULL_BITS - tz);
+	}
+
+	// Divide by the odd part
+	if(d_abs >> tz > 1)
+		divexact_1(wp, wp, n, d_abs >> tz);
+
+	// Correct the sign
+	if(d < 0)
+		neg_n(wp, wp, n);
+}
+
+
+// Interpolate product coefficients from the values at d finite Toom points, each n words in two's complement,
+// and the leading coefficient winf. Coefficients 0 to d-1 replace the point values
+// Uses Newton divided differences, so any Toom split shares the same sequence
+void LargeUnsignedInteger::toom_interpolate(ull_t* wp, const ull_t* winf, unsigned int d, unsigned int n) {
+	long long x;	// evaluation point
+	ull_t x_pow;	// |x|^d
+
+	// Remove the leading term from each point value
+	for(unsigned int i = 1;  i < d;  ++i) {
+		x = toom_point(i);
+		x_pow = 1;
+		for(unsigned int j = 0;  j < d;  ++j)
+			x_pow *= (x < 0 ? -x : x);
+
+		if(x < 0 && d % 2 == 1)
+			addmul_1(wp + i*n, winf, n, x_pow);
+		else
+			submul_1(wp + i*n, winf, n, x_pow);
+	}
+
+	// Newton divided differences
+	for(unsigned int l = 1;  l < d;  ++l) {
+		for(unsigned int i = d-1;  i >= l;  --i) {
+			sub_n(wp + i*n, wp + i*n, wp + (i-1)*n, n);
+			toom_divexact(wp + i*n, n, toom_point(i) - toom_point(i-l));
+		}
+	}
+
+	// Convert from Newton basis to monomial basis
+	for(unsigned int l = d-2;  l < d;  --l) {
+		x = toom_point(l);
+
+		for(unsigned int i = l;  i < d-1  &&  x != 0;  ++i) {
+			if(x > 0)
+				submul_1(wp + i*n, wp + (i+1)*n, n, x);
+			else
+				addmul_1(wp + i*n, wp + (i+1)*n, n, -x);
+		}
+	}
+}
+
+
+// Toom-Cook multiplication of un words of up by vn words of vp into un+vn words of rp
+// up is split into ku parts and vp into kv parts of equal length, the last parts may be shorter
+// Parts are evaluated at 0, 1, -1, 2, -2, ... and infinity, giving Toom-3 for (3, 3), Toom-4 for (4, 4),
+// and the unbalanced Toom-32 and Toom-42 for (3, 2) and (4, 2)
+// rp must not overlap either operand or scratch
+void LargeUnsignedInteger::mul_toom(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn, unsigned int ku, unsigned int kv, ull_t* scratch) {
+	unsigned int k = toom_part_size(un, vn, ku, kv);	// part length
+	unsigned int su = un - (ku-1)*k;					// top part length of up
+	unsigned int sv = vn - (kv-1)*k;					// top part length of vp
+	unsigned int d = ku + kv - 2;						// product degree, and number of finite points
+	unsigned int n = 2*k + 2;							// point value length
+	unsigned int rn = un + vn;							// product length
+	bool square = up == vp && un == vn;				// operands are the same number
+
+	ull_t* w = scratch;				// finite point values
+	ull_t* winf = w + d*n;			// value at infinity
+	ull_t* eu = winf + n;			// even and odd parts of u(x) and v(x)
+	ull_t* ou = eu + (k+1);
+	ull_t* ev = ou + (k+1);
+	ull_t* ov = ev + (k+1);
+	ull_t* pu = ov + (k+1);			// |u(x)| and |v(x)|
+	ull_t* pv = pu + (k+1);
+	ull_t* t = pv + (k+1);			// scratch for recursion
+
+	// Value at 0
+	mul_n(w, up, vp, k, t);
+	for(unsigned int i = 2*k;  i < n;  ++i)
+		w[i] = 0;
+
+	// Value at infinity
+	if(su == sv)
+		mul_n(winf, up + (ku-1)*k, vp + (kv-1)*k, su, t);
+	else
+		mul(winf, up + (ku-1)*k, su, vp + (kv-1)*k, sv);
+	for(unsigned int i = su + sv;  i < n;  ++i)
+		winf[i] = 0;
+
+	// Values at j and -j
+	for(unsigned int i = 1;  i < d;  i += 2) {
+		ull_t j = (i+1) / 2;
+
+		toom_eval(eu, ou, up, ku, k, su, j);
+
+		// u(j) * v(j). Squaring uses pu for both
+		add_n(pu, eu, ou, k+1);
+		if(!square) {
+			toom_eval(ev, ov, vp, kv, k, sv, j);
+			add_n(pv, ev, ov, k+1);
+		}
+		mul_n(w + i*n, pu, square ? pu : pv, k+1, t);
+
+		// u(-j) * v(-j)
+		if(i+1 < d) {
+			bool neg = abs_diff(pu, eu, k+1, ou, k+1);
+			if(!square)
+				neg = neg != abs_diff(pv, ev, k+1, ov, k+1);
+
+			mul_n(w + (i+1)*n, pu, square ? pu : pv, k+1, t);
+			if(neg && !square)
+				neg_n(w + (i+1)*n, w + (i+1)*n, n);
+		}
+	}
+
+	// Recover product coefficients
+	toom_interpolate(w, winf, d, n);
+
+	// Clear product
+	for(unsigned int i = 0;  i < rn;  ++i)
+		rp[i] = 0;
+
+	// Accumulate coefficients at offsets of k words
+	for(unsigned int i = 0;  i <= d;  ++i) {
+		const ull_t* c = (i < d) ? w + i*n : winf;
+		unsigned int len = (n < rn - i*k) ? n : rn - i*k;
+		add(rp + i*k, rp + i*k, rn - i*k, c, len);
+	}
+}
+
+
+
+// Return the NTT length used for a product of rn words: the least 2^k at least rn, or 3 * 2^k from
+// FFT_RADIX3_THRESHOLD words when that is shorter. Throws if the length doesn't fit in words
+unsigned int LargeUnsignedInteger::fft_length(unsigned int rn) {
+	ull_t len = 2;
+	while(len < rn)
+		len *= 2;
+
+	if(rn >= FFT_RADIX3_THRESHOLD  &&  len / 4 * 3 >= rn)
+		len = len / 4 * 3;
+
+	if(len > UINT_MAX)
+		throw std::length_error("Product is too long for the NTT.");
+
+	return len;
+}
+
+
+// Montgomery product a * b / 2^64 modulo p, where p_neg_inv = -1/p modulo 2^64
+// Requires p < 2^62 and a * b < 2^64 * p
+ull_t LargeUnsignedInteger::fft_mulmod(ull_t a, ull_t b, ull_t p, ull_t p_neg_inv) {
+	u128_t t = static_cast<u128_t>(a) * b;
+	ull_t m = static_cast<ull_t>(t) * p_neg_inv;
+	ull_t r = static_cast<ull_t>((t + static_cast<u128_t>(m) * p) >> ULL_BITS);
+	return r >= p ? r - p : r;
+}
+
+
+// Return a^e modulo p, without Montgomery form
+ull_t LargeUnsignedInteger::fft_powmod(ull_t a, ull_t e, ull_t p) {
+	ull_t r = 1;
+
+	for(;  e > 0;  e >>= 1) {
+		if(e & 1)
+			r = static_cast<ull_t>(static_cast<u128_t>(r) * a % p);
+		a = static_cast<ull_t>(static_cast<u128_t>(a) * a % p);
+	}
+
+	return r;
+}
+
+
+// Forward NTT of len words in place, by decimation in frequency. Output is in bit-reversed order
+// roots holds the Montgomery form of w^i for i < len/2, where w is a primitive len-th root of unity
+void LargeUnsignedInteger::fft_forward(ull_t* ap, unsigned int len, const ull_t* roots, ull_t p, ull_t p_neg_inv) {
+	ull_t x, y, sum;
+
+	// Iterate through butterfly spans
+	for(unsigned int m = len/2;  m >= 1;  m /= 2) {
+		unsigned int stride = len / (2*m);
+
+		for(unsigned int s = 0;  s < len;  s += 2*m) {
+			for(unsigned int j = 0;  j < m;  ++j) {
+				x = ap[s+j];
+				y = ap[s+j+m];
+
+				sum = x + y;
+				ap[s+j] = sum >= p ? sum - p : sum;
+				ap[s+j+m] = fft_mulmod(x + p - y, roots[j*stride], p, p_neg_inv);
+			}
+		}
+	}
+}
+
+
+// Inverse NTT of len words in place, by decimation in time. Input is in bit-reversed order
+// roots holds the Montgomery form of w^-i for i < len/2. Output is scaled by len
+void LargeUnsignedInteger::fft_inverse(ull_t* ap, unsigned int len, const ull_t* roots, ull_t p, ull_t p_neg_inv) {
+	ull_t x, y, sum;
+
+	// Iterate through butterfly spans
+	for(unsigned int m = 1;  m < len;  m *= 2) {
+		unsigned int stride = len / (2*m);
+
+		for(unsigned int s = 0;  s < len;  s += 2*m) {
+			for(unsigned int j = 0;  j < m;  ++j) {
+				x = ap[s+j];
+				y = fft_mulmod(ap[s+j+m], roots[j*stride], p, p_neg_inv);
+
+				sum = x + y;
+				ap[s+j] = sum >= p ? sum - p : sum;
+				ap[s+j+m] = x >= y ? x - y : x + p - y;
+			}
+		}
+	}
+}
+
+
+// Forward radix-3 layer of a length 3m NTT in place, ahead of fft_forward() on each third
+// w is the Montgomery form of a primitive 3m-th root of unity, and omega of w^m. Third r then transforms to the outputs
+// 3i + r
+void LargeUnsignedInteger::fft_forward3(ull_t* ap, unsigned int m, ull_t w, ull_t omega, ull_t p, ull_t p_neg_inv) {
+	ull_t omega2 = fft_mulmod(omega, omega, p, p_neg_inv);	// Montgomery forms of omega^2 and w^2
+	ull_t w2 = fft_mulmod(w, w, p, p_neg_inv);
+	ull_t tw1 = static_cast<ull_t>((static_cast<u128_t>(1) << ULL_BITS) % p);	// twiddles w^j and w^2j
+	ull_t tw2 = tw1;
+	ull_t a, s, t, y;
+
+	for(unsigned int j = 0;  j < m;  ++j) {
+		a = ap[j];
+
+		// b + c, and omega * b + omega^2 * c
+		s = ap[j+m] + ap[j+2*m];
+		s = s >= p ? s - p : s;
+		t = fft_mulmod(ap[j+m], omega, p, p_neg_inv) + fft_mulmod(ap[j+2*m], omega2, p, p_neg_inv);
+		t = t >= p ? t - p : t;
+
+		y = a + s;
+		ap[j] = y >= p ? y - p : y;
+
+		y = a + t;
+		ap[j+m] = fft_mulmod(y >= p ? y - p : y, tw1, p, p_neg_inv);
+
+		// a + omega^2 * b + omega * c = a - s - t, since 1 + omega + omega^2 = 0
+		y = a + 2*p - s - t;
+		y = y >= p ? y - p : y;
+		ap[j+2*m] = fft_mulmod(y >= p ? y - p : y, tw2, p, p_neg_inv);
+
+		tw1 = fft_mulmod(tw1, w, p, p_neg_inv);
+		tw2 = fft_mulmod(tw2, w2, p, p_neg_inv);
+	}
+}
+
+
+// Inverse radix-3 layer of a length 3m NTT in place, after fft_inverse() on each third. Output is scaled by 3
+// w is the Montgomery form of the inverse of the forward root, and omega of w^m
+void LargeUnsignedInteger::fft_inverse3(ull_t* ap, unsigned int m, ull_t w, ull_t omega, ull_t p, ull_t p_neg_inv) {
+	ull_t omega2 = fft_mulmod(omega, omega, p, p_neg_inv);	// Montgomery forms of omega^2 and w^2
+	ull_t w2 = fft_mulmod(w, w, p, p_neg_inv);
+	ull_t tw1 = static_cast<ull_t>((static_cast<u128_t>(1) << ULL_BITS) % p);	// twiddles w^j and w^2j
+	ull_t tw2 = tw1;
+	ull_t a, b, c, s, t, y;
+
+	for(unsigned int j = 0;  j < m;  ++j) {
+		a = ap[j];
+		b = fft_mulmod(ap[j+m], tw1, p, p_neg_inv);
+		c = fft_mulmod(ap[j+2*m], tw2, p, p_neg_inv);
+
+		// b + c, and omega * b + omega^2 * c
+		s = b + c;
+		s = s >= p ? s - p : s;
+		t = fft_mulmod(b, omega, p, p_neg_inv) + fft_mulmod(c, omega2, p, p_neg_inv);
+		t = t >= p ? t - p : t;
+
+		y = a + s;
+		ap[j] = y >= p ? y - p : y;
+
+		y = a + t;
+		ap[j+m] = y >= p ? y - p : y;
+
+		// a + omega^2 * b + omega * c = a - s - t
+		y = a + 2*p - s - t;
+		y = y >= p ? y - p : y;
+		ap[j+2*m] = y >= p ? y - p : y;
+
+		tw1 = fft_mulmod(tw1, w, p, p_neg_inv);
+		tw2 = fft_mulmod(tw2, w2, p, p_neg_inv);
+	}
+}
+
+
+// NTT multiplication of un words of up by vn words of vp into un+vn words of rp
+// Convolves the words modulo three primes and reconstructs each coefficient by CRT
+// Squaring is detected when up and vp are the same. A length 3 * 2^k takes one radix-3 layer, then a power-of-two
+// transform on each third
+// rp must not overlap either operand
+void LargeUnsignedInteger::mul_fft(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn) {
+	unsigned int rn = un + vn;				// product length
+	unsigned int len = fft_length(rn);		// transform length
+	unsigned int m = len % 3 ? len : len / 3;	// power-of-two transform length
+	bool square = up == vp && un == vn;	// operands are the same number
+
+	ull_t* buf = new ull_t[2*(size_t)len + m + 3*(size_t)rn];
+	ull_t* fu = buf;					// transform of up
+	ull_t* fv = fu + len;				// transform of vp
+	ull_t* roots = fv + len;			// forward roots
+	ull_t* roots_inv = roots + m/2;		// inverse roots
+	ull_t* res = roots_inv + m/2;		// convolution modulo each prime
+
+	// Convolve modulo each prime
+	for(unsigned int k = 0;  k < 3;  ++k) {
+		ull_t p = FFT_PRIMES[k];
+
+		// Montgomery constants
+		ull_t p_inv = p;
+		for(unsigned int i = 0;  i < 5;  ++i)
+			p_inv *= 2 - p * p_inv;
+		ull_t p_neg_inv = -p_inv;
+		ull_t r1 = static_cast<ull_t>((static_cast<u128_t>(1) << ULL_BITS) % p);	// 2^64 mod p
+		ull_t r2 = static_cast<ull_t>(static_cast<u128_t>(r1) * r1 % p);			// 2^128 mod p
+
+		// Root tables for the power-of-two transforms, of w^(len/m)
+		ull_t w = fft_powmod(FFT_GENERATORS[k], (p-1) / len, p);
+		ull_t w_inv = fft_powmod(w, p-2, p);
+		ull_t w_mont = fft_mulmod(w, r2, p, p_neg_inv);
+		ull_t w_inv_mont = fft_mulmod(w_inv, r2, p, p_neg_inv);
+		ull_t wm_mont = fft_mulmod(fft_powmod(w, len/m, p), r2, p, p_neg_inv);
+		ull_t wm_inv_mont = fft_mulmod(fft_powmod(w_inv, len/m, p), r2, p, p_neg_inv);
+
+		roots[0] = r1;
+		roots_inv[0] = r1;
+		for(unsigned int i = 1;  i < m/2;  ++i) {
+			roots[i] = fft_mulmod(roots[i-1], wm_mont, p, p_neg_inv);
+			roots_inv[i] = fft_mulmod(roots_inv[i-1], wm_inv_mont, p, p_neg_inv);
+		}
+
+		// Reduce operands
+		for(unsigned int i = 0;  i < len;  ++i)
+			fu[i] = i < un ? up[i] % p : 0;
+		if(!square) {
+			for(unsigned int i = 0;  i < len;  ++i)
+				fv[i] = i < vn ? vp[i] % p : 0;
+		}
+
+		// Cube roots of unity w^m, for the radix-3 layer of lengths 3 * 2^k
+		ull_t omega = fft_mulmod(fft_powmod(w, m, p), r2, p, p_neg_inv);
+		ull_t omega_inv = fft_mulmod(fft_powmod(w_inv, m, p), r2, p, p_neg_inv);
+
+		// Transform, multiply pointwise, and transform back. Squaring transforms once
+
+		if(m < len)
+			fft_forward3(fu, m, w_mont, omega, p, p_neg_inv);
+		for(unsigned int i = 0;  i < len;  i += m)
+			fft_forward(fu + i, m, roots, p, p_neg_inv);
+
+		if(!square) {
+			if(m < len)
+				fft_forward3(fv, m, w_mont, omega, p, p_neg_inv);
+			for(unsigned int i = 0;  i < len;  i += m)
+				fft_forward(fv + i, m, roots, p, p_neg_inv);
+		}
+
+		for(unsigned int i = 0;  i < len;  ++i)
+			fu[i] = fft_mulmod(fu[i], square ? fu[i] : fv[i], p, p_neg_inv);
+
+		for(unsigned int i = 0;  i < len;  i += m)
+			fft_inverse(fu + i, m, roots_inv, p, p_neg_inv);
+		if(m < len)
+			fft_inverse3(fu, m, w_inv_mont, omega_inv, p, p_neg_inv);
+
+		// Remove the factor len from the inverse transform and 1/2^64 from the pointwise product
+		ull_t scale = static_cast<ull_t>(static_cast<u128_t>(r2) * fft_powmod(len, p-2, p) % p);
+		for(unsigned int i = 0;  i < rn;  ++i)
+			res[(size_t)k*rn + i] = fft_mulmod(fu[i], scale, p, p_neg_inv);
+	}
+
+	fft_crt(rp, res, rn);
+
+	delete[] buf;
+}
+
+
+// Reconstruct rn coefficients from their residues modulo the three NTT primes, and accumulate them
+// at word offsets into rn words of rp. res holds rn residues per prime
+void LargeUnsignedInteger::fft_crt(ull_t* rp, const ull_t* res, unsigned int rn) {
+	const ull_t p1 = FFT_PRIMES[0];
+	const ull_t p2 = FFT_PRIMES[1];
+	const ull_t p3 = FFT_PRIMES[2];
+
+	// Montgomery constants for p2 and p3
+	ull_t p2_neg_inv = p2;
+	ull_t p3_neg_inv = p3;
+	for(unsigned int i = 0;  i < 5;  ++i) {
+		p2_neg_inv *= 2 - p2 * p2_neg_inv;
+		p3_neg_inv *= 2 - p3 * p3_neg_inv;
+	}
+	p2_neg_inv = -p2_neg_inv;
+	p3_neg_inv = -p3_neg_inv;
+
+	// Garner constants in Montgomery form, so fft_mulmod() yields plain products
+	u128_t p12 = static_cast<u128_t>(p1) * p2;
+	ull_t p1_inv_p2 = static_cast<ull_t>((static_cast<u128_t>(fft_powmod(p1 % p2, p2-2, p2)) << ULL_BITS) % p2);
+	ull_t p12_inv_p3 = static_cast<ull_t>((static_cast<u128_t>(fft_powmod(static_cast<ull_t>(p12 % p3), p3-2, p3)) << ULL_BITS) % p3);
+	ull_t p1_p3 = static_cast<ull_t>((static_cast<u128_t>(p1 % p3) << ULL_BITS) % p3);
+	ull_t p12_lo = static_cast<ull_t>(p12);
+	ull_t p12_hi = static_cast<ull_t>(p12 >> ULL_BITS);
+
+	ull_t acc0 = 0, acc1 = 0, acc2 = 0;	// running sum, shifted one word per coefficient
+	ull_t t1, t2, t3;					// mixed-radix digits
+	u128_t x12, lo, hi, s;
+
+	for(unsigned int i = 0;  i < rn;  ++i) {
+		// x = t1 + p1 * t2 + p1 * p2 * t3
+		t1 = res[i];
+		t2 = res[(size_t)rn + i] + p2 - t1 % p2;
+		t2 = fft_mulmod(t2 >= p2 ? t2 - p2 : t2, p1_inv_p2, p2, p2_neg_inv);
+		x12 = t1 + static_cast<u128_t>(p1) * t2;
+
+		t3 = (t1 % p3 + fft_mulmod(t2, p1_p3, p3, p3_neg_inv)) % p3;
+		t3 = res[2*(size_t)rn + i] + p3 - t3;
+		t3 = fft_mulmod(t3 >= p3 ? t3 - p3 : t3, p12_inv_p3, p3, p3_neg_inv);
+
+		lo = static_cast<u128_t>(p12_lo) * t3;
+		hi = static_cast<u128_t>(p12_hi) * t3 + (lo >> ULL_BITS);
+
+		// Accumulate the three words of x
+		s = static_cast<u128_t>(acc0) + static_cast<ull_t>(lo) + static_cast<ull_t>(x12);
+		acc0 = static_cast<ull_t>(s);
+		s = static_cast<u128_t>(acc1) + static_cast<ull_t>(hi) + static_cast<ull_t>(x12 >> ULL_BITS) + (s >> ULL_BITS);
+		acc1 = static_cast<ull_t>(s);
+		acc2 += static_cast<ull_t>(hi >> ULL_BITS) + static_cast<ull_t>(s >> ULL_BITS);
+
+		// Emit lowest word
+		rp[i] = acc0;
+		acc0 = acc1;
+		acc1 = acc2;
+		acc2 = 0;
+	}
+}
+
+
+// Divide nn words of np by dn words of dp into nn-dn words of qp, leaving the remainder in the low dn words of np
+// dp must be normalized with its top bit set, with v = invert_limb(dp[dn-1]), and dn >= 2. Return the high quotient
+// word, 1 if the top dn words of np are at least dp, else 0
+// Schoolbook long division (Knuth Algorithm D), dividing the top 3 words of the running remainder by the top 2
+// words of the divisor with a 3-by-2 reciprocal, so each quotient word is found without branching on estimates
+// and at most one add-back correction is needed
+ull_t LargeUnsignedInteger::div_basecase(ull_t* qp, ull_t* np, unsigned int nn, const ull_t* dp, unsigned int dn, ull_t v) {
+	ull_t d1 = dp[dn-1];					// top divisor word
+	ull_t d0 = dp[dn-2];					// next divisor word
+	ull_t dinv = invert_pi1(d1, d0, v);		// 3-by-2 reciprocal
+
+	ull_t n2, n1, n0;		// top words of running remainder
+	ull_t r1, r0;			// remainder of 3-by-2 division
+	ull_t q;				// quotient word
+	ull_t borrow;
+
+	// High quotient word. Normalization bounds the top dn words of np below 2 * dp
+	ull_t qh = cmp_n(np+nn-dn, dp, dn) >= 0;
+	if(qh)
+		sub_n(np+nn-dn, np+nn-dn, dp, dn);
+
+	// Reverse-iterate through quotient words
+	for(unsigned int j = nn-dn-1;  j < nn-dn;  --j) {
+		n2 = np[j+dn];
+		n1 = np[j+dn-1];
+		n0 = np[j+dn-2];
+
+		// Top words equal to the divisor's cap the quotient word at one word, which is at most 1 too large
+		if(n2 == d1  &&  n1 == d0) {
+			q = ULL_MAX;
+			borrow = submul_1(np+j, dp, dn, q);
+			np[j+dn] = n2 - borrow;
+
+			if(n2 < borrow) {
+				--q;
+				np[j+dn] += add_n(np+j, np+j, dp, dn);
+			}
+		}
+
+		// Quotient word of the top 3 words, and the remainder of those words. Subtract q times the rest of dp
+		// below them, and borrow from the remainder
+		else {
+			q = div_3by2(r1, r0, n2, n1, n0, d1, d0, dinv);
+
+			borrow = submul_1(np+j, dp, dn-2, q);
+			np[j+dn-2] = r0 - borrow;
+			borrow = r0 < borrow;
+			np[j+dn-1] = r1 - borrow;
+			borrow = r1 < borrow;
+			np[j+dn] = 0;
+
+			// Add back if the quotient word was 1 too large
+			if(borrow) {
+				--q;
+				np[j+dn-1] += d1 + add_n(np+j, np+j, dp, dn-1);
+			}
+		}
+
+		qp[j] = q;
+	}
+
+	return qh;
+}
+
+
+// Return the reciprocal floor((2^128 - 1) / d) - 2^64 of a normalized word d, with its top bit set
+ull_t LargeUnsignedInteger::invert_limb(ull_t d) {
+	return static_cast<ull_t>((~static_cast<u128_t>(0) - (static_cast<u128_t>(d) << ULL_BITS)) / d);
+}
+
+
+// Divide two words u1:u0 by normalized word d with reciprocal v = invert_limb(d), where u1 < d
+// Return quotient word and store remainder in r. Needs no hardware division (Moller & Granlund, Algorithm 4)
+ull_t LargeUnsignedInteger::div_2by1(ull_t& r, ull_t u1, ull_t u0, ull_t d, ull_t v) {
+	u128_t q = static_cast<u128_t>(v) * u1 + (static_cast<u128_t>(u1) << ULL_BITS | u0);
+	ull_t q1 = static_cast<ull_t>(q >> ULL_BITS) + 1;
+	ull_t q0 = static_cast<ull_t>(q);
+
+	r = u0 - q1 * d;
+
+	// Quotient estimate is at most 1 too large or 1 too small
+	if(r > q0) {
+		--q1;
+		r += d;
+	}
+	if(r >= d) {
+		++q1;
+		r -= d;
+	}
+
+	return q1;
+}
+
+
+// Return the reciprocal floor((2^192 - 1) / (d1:d0)) - 2^64 of a normalized 2-word divisor, from v = invert_limb(d1)
+// Adjusts v for the low word d0 (Moller & Granlund, Algorithm 6)
+ull_t LargeUnsignedInteger::invert_pi1(ull_t d1, ull_t d0, ull_t v) {
+	ull_t p = d1 * v + d0;
+	ull_t mask;
+
+	if(p < d0) {
+		--v;
+		mask = -static_cast<ull_t>(p >= d1);
+		p -= d1;
+		v += mask;
+		p -= mask & d1;
+	}
+
+	u128_t t = static_cast<u128_t>(d0) * v;
+	ull_t t1 = static_cast<ull_t>(t >> ULL_BITS);
+	ull_t t0 = static_cast<ull_t>(t);
+
+	p += t1;
+	if(p < t1) {
+		--v;
+		if(p > d1  ||  (p == d1  &&  t0 >= d0))
+			--v;
+	}
+
+	return v;
+}
+
+
+// Divide three words n2:n1:n0 by normalized two words d1:d0 with reciprocal v = invert_pi1(d1, d0), where
+// n2:n1 < d1:d0. Return quotient word and store the remainder in r1:r0 (Moller & Granlund, Algorithm 5)
+ull_t LargeUnsignedInteger::div_3by2(ull_t& r1, ull_t& r0, ull_t n2, ull_t n1, ull_t n0, ull_t d1, ull_t d0, ull_t v) {
+	u128_t d = static_cast<u128_t>(d1) << ULL_BITS | d0;
+	u128_t q = static_cast<u128_t>(v) * n2 + (static_cast<u128_t>(n2) << ULL_BITS | n1);
+	ull_t q1 = static_cast<ull_t>(q >> ULL_BITS);
+	ull_t q0 = static_cast<ull_t>(q);
+
+	// Top two words of n - q1 * d, modulo 2^128
+	u128_t r = static_cast<u128_t>(n1 - d1 * q1) << ULL_BITS | n0;
+	r -= d;
+	r -= static_cast<u128_t>(d0) * q1;
+	++q1;
+
+	// Quotient estimate is 1 too large, without branching
+	ull_t mask = -static_cast<ull_t>(static_cast<ull_t>(r >> ULL_BITS) >= q0);
+	q1 += mask;
+	r += d & (static_cast<u128_t>(mask) << ULL_BITS | mask);
+
+	// Rarely 1 too small
+	if(r >= d) {
+		++q1;
+		r -= d;
+	}
+
+	r1 = static_cast<ull_t>(r >> ULL_BITS);
+	r0 = static_cast<ull_t>(r);
+
+	return q1;
+}
+
+
+// Divide n words of up by word d into n words of qp. Return remainder
+// One 2-by-1 reciprocal division per word. qp may be equal to up
+ull_t LargeUnsignedInteger::div_1(ull_t* qp, const ull_t* up, unsigned int n, ull_t d) {
+	unsigned int shift = __builtin_clzll(d);
+	return div_1_preinv(qp, up, n, d << shift, shift, invert_limb(d << shift));
+}
+
+
+// Divide n words of up by word d into n words of qp. Return remainder
+// d must be normalized, as the divisor shifted left by shift bits, with v = invert_limb(d). qp may be equal to up
+ull_t LargeUnsignedInteger::div_1_preinv(ull_t* qp, const ull_t* up, unsigned int n, ull_t d, unsigned int shift, ull_t v) {
+	ull_t r = 0;	// running remainder
+	ull_t u;		// next dividend word, shifted
+
+	// Reverse-iterate through words, shifting dividend words on the fly
+	if(shift) {
+		r = up[n-1] >> (ULL_BITS - shift);
+		for(unsigned int i = n-1;  i > 0;  --i) {
+			u = (up[i] << shift) | (up[i-1] >> (ULL_BITS - shift));
+			qp[i] = div_2by1(r, r, u, d, v);
+		}
+		qp[0] = div_2by1(r, r, up[0] << shift, d, v);
+	}
+	else
+		for(unsigned int i = n-1;  i < n;  --i)
+			qp[i] = div_2by1(r, r, up[i], d, v);
+
+	// Denormalize remainder
+	return r >> shift;
+}
+
+
+// Return the remainder of n words of up divided by word d
+ull_t LargeUnsignedInteger::mod_1(const ull_t* up, unsigned int n, ull_t d) {
+	unsigned int shift = __builtin_clzll(d);
+	return mod_1_preinv(up, n, d << shift, shift, invert_limb(d << shift));
+}
+
+
+// Return the remainder of n words of up divided by word d
+// d must be normalized, as the divisor shifted left by shift bits, with v = invert_limb(d)
+ull_t LargeUnsignedInteger::mod_1_preinv(const ull_t* up, unsigned int n, ull_t d, unsigned int shift, ull_t v) {
+	ull_t r = 0;	// running remainder
+	ull_t u;		// next dividend word, shifted
+
+	// Reverse-iterate through words, shifting dividend words on the fly
+	if(shift) {
+		r = up[n-1] >> (ULL_BITS - shift);
+		for(unsigned int i = n-1;  i > 0;  --i) {
+			u = (up[i] << shift) | (up[i-1] >> (ULL_BITS - shift));
+			div_2by1(r, r, u, d, v);
+		}
+		div_2by1(r, r, up[0] << shift, d, v);
+	}
+	else
+		for(unsigned int i = n-1;  i < n;  --i)
+			div_2by1(r, r, up[i], d, v);
+
+	// Denormalize remainder
+	return r >> shift;
+}
+
+
+// Divide 2n words of np by n words of dp into n words of qp, leaving the remainder in the low n words of np
+// dp must be normalized with its top bit set, with v = invert_limb(dp[n-1]). Return the high quotient word, as for
+// div_basecase
+// Recursive division (Burnikel & Ziegler): the top half of the quotient comes from dividing the top of np by the
+// top half of dp, then is corrected by multiplying with the low half of dp. Likewise for the low half. Scratch
+// must hold n words
+ull_t LargeUnsignedInteger::div_dc_n(ull_t* qp, ull_t* np, const ull_t* dp, unsigned int n, ull_t v, ull_t* scratch) {
+	// Base case. Halves must stay at least 2 words long
+	if(n < DIV_DC_THRESHOLD  ||  n < 4)
+		return div_basecase(qp, np, 2*n, dp, n, v);
+
+	unsigned int lo = n / 2;	// words of low quotient half
+	unsigned int hi = n - lo;	// words of high quotient half
+	ull_t borrow;
+
+	// High quotient half from the top 2*hi words of np and the top hi words of dp
+	ull_t qh = div_dc_n(qp+lo, np+2*lo, dp+lo, hi, v, scratch);
+
+	// Subtract high quotient half times low divisor half. The quotient estimate is at most 2 too large
+	mul(scratch, qp+lo, hi, dp, lo);
+	borrow = sub_n(np+lo, np+lo, scratch, n);
+	if(qh)
+		borrow += sub_n(np+n, np+n, dp, lo);
+
+	while(borrow) {
+		qh -= sub_1(qp+lo, qp+lo, hi, 1);
+		borrow -= add_n(np+lo, np+lo, dp, n);
+	}
+
+	// Low quotient half from the next 2*lo words of np and the top lo words of dp
+	ull_t ql = div_dc_n(qp, np+hi, dp+hi, lo, v, scratch);
+
+	// Subtract low quotient half times low divisor half
+	mul(scratch, dp, hi, qp, lo);
+	borrow = sub_n(np, np, scratch, n);
+	if(ql)
+		borrow += sub_n(np+lo, np+lo, dp, hi);
+
+	while(borrow) {
+		sub_1(qp, qp, lo, 1);
+		borrow -= add_n(np, np, dp, n);
+	}
+
+	return qh;
+}
+
+
+// Divide nn words of np by dn words of dp into nn-dn words of qp, leaving the remainder in the low dn words of np
+// dp must be normalized with its top bit set, with v = invert_limb(dp[dn-1]), and the top dn words of np must be
+// less than dp
+// Quotient words are produced dn at a time with div_dc_n, then any remainder block is divided by the top of dp
+// and corrected like a half step of div_dc_n
+void LargeUnsignedInteger::div_dc(ull_t* qp, ull_t* np, unsigned int nn, const ull_t* dp, unsigned int dn, ull_t v) {
+	unsigned int qn = nn - dn;				// quotient words left
+	ull_t* scratch = new ull_t[dn];
+
+	// Full blocks of dn quotient words, from the top
+	while(qn >= dn) {
+		qn -= dn;
+		div_dc_n(qp+qn, np+qn, dp, dn, v, scratch);
+	}
+
+	// Short remainder block is cheap to do by schoolbook division
+	if(qn < DIV_DC_THRESHOLD  ||  qn < 4) {
+		if(qn)
+			div_basecase(qp, np, qn+dn, dp, dn, v);
+	}
+
+	// Long remainder block. Divide the top 2*qn words by the top qn words of dp, then correct with the rest of dp
+	else {
+		ull_t qh = div_dc_n(qp, np+dn-qn, dp+dn-qn, qn, v, scratch);
+
+		mul(scratch, qp, qn, dp, dn-qn);
+		ull_t borrow = sub_n(np, np, scratch, dn);
+		if(qh)
+			borrow += sub_n(np+qn, np+qn, dp, dn-qn);
+
+		while(borrow) {
+			sub_1(qp, qp, qn, 1);
+			borrow -= add_n(np, np, dp, dn);
+		}
+	}
+
+	delete[] scratch;
+}
@@ -1,146 +1,292 @@
-
-#ifndef LARGEUNSIGNEDINTEGER_H_
-#define LARGEUNSIGNEDINTEGER_H_
-
-
-#include <iostream>
-#include <string>
-#include <utility>
-
-
-#define ULL_MAX 0xFFFF'FFFF'FFFF'FFFFull
-
-#define PRINT_DEBUG(obj) obj.print_debug(#obj)
-
-#define MIN(a, b) (a < b) ? (a) : (b)
-#define MAX(a, b) (a > b) ? (a) : (b)
-
-class LargeUnsignedInteger;
-
-using ull_t = unsigned long long;
-using quot_rem = std::pair<LargeUnsignedInteger, LargeUnsignedInteger>;
-
-
-
-class LargeUnsignedInteger {
-private:
-	unsigned int num_segments;
-	ull_t* arr;	// little-endian
-	unsigned int* arr_half;
-
-	bool is_separating_char(char c);
-	void construct_string_bin(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
-	void construct_string_oct(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
-	void construct_string_dec(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
-	void construct_string_hex(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
-
-	void assign_arr(ull_t* arr_new);
-	void refresh_arr_half();
-
-	void resize(unsigned int len);
-	void trim();
-
-	static const ull_t NUM_ONE_TENTH_INIT;
-	static const ull_t NUM_ONE_TENTH;
-	static const ull_t DEN_POW_ONE_TENTH;
-	unsigned int div_mod_ten(const LargeUnsignedInteger& num, const ull_t& den_pow);
-
-
-public:
-	static const unsigned int UINT_BITS;
-	static const unsigned int ULL_BITS;
-
-	LargeUnsignedInteger();
-	LargeUnsignedInteger(ull_t num);
-	LargeUnsignedInteger(unsigned int len, const ull_t* nums);
-	LargeUnsignedInteger(const std::string& str);
-	LargeUnsignedInteger(const LargeUnsignedInteger& rhs);	// copy constructor
-	LargeUnsignedInteger(LargeUnsignedInteger&& rhs);		// move constructor
-	~LargeUnsignedInteger();								// destructor
-
-	unsigned int get_size() const;
-
-	bool is_zero() const;
-
-	void reset();
-	void set(ull_t num);
-	void set(unsigned int len, const ull_t* nums);
-	void set(const std::string& str);
-
-	ull_t get_low_word() const;
-
-	LargeUnsignedInteger operator+(const LargeUnsignedInteger& rhs) const;
-	LargeUnsignedInteger operator+(const ull_t& rhs) const;
-
-	LargeUnsignedInteger operator-(const LargeUnsignedInteger& rhs) const;
-	LargeUnsignedInteger operator-(const ull_t& rhs) const;
-
-	LargeUnsignedInteger operator*(const LargeUnsignedInteger& rhs) const;
-	LargeUnsignedInteger operator*(const ull_t& rhs) const;
-
-	quot_rem div_mod(const LargeUnsignedInteger& rhs) const;
-	quot_rem div_mod(const ull_t& rhs) const;
-
-	LargeUnsignedInteger operator/(const LargeUnsignedInteger& rhs) const;
-	LargeUnsignedInteger operator/(const ull_t& rhs) const;
-
-	LargeUnsignedInteger operator%(const LargeUnsignedInteger& rhs) const;
-	LargeUnsignedInteger operator%(const ull_t& rhs) const;
-
-	LargeUnsignedInteger operator<<(const ull_t& rhs) const;
-	LargeUnsignedInteger operator>>(const ull_t& rhs) const;
-
-	bool operator<(const LargeUnsignedInteger& rhs) const;
-	bool operator<(const ull_t& rhs) const;
-
-	bool operator>(const LargeUnsignedInteger& rhs) const;
-	bool operator>(const ull_t& rhs) const;
-
-	bool operator<=(const LargeUnsignedInteger& rhs) const;
-	bool operator<=(const ull_t& rhs) const;
-
-	bool operator>=(const LargeUnsignedInteger& rhs) const;
-	bool operator>=(const ull_t& rhs) const;
-
-	bool operator==(const LargeUnsignedInteger& rhs) const;
-	bool operator==(const ull_t& rhs) const;
-
-	bool operator!=(const LargeUnsignedInteger& rhs) const;
-	bool operator!=(const ull_t& rhs) const;
-
-	LargeUnsignedInteger& operator+=(const LargeUnsignedInteger& rhs);
-	LargeUnsignedInteger& operator+=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator-=(const LargeUnsignedInteger& rhs);
-	LargeUnsignedInteger& operator-=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator*=(const LargeUnsignedInteger& rhs);
-	LargeUnsignedInteger& operator*=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator/=(const LargeUnsignedInteger& rhs);
-	LargeUnsignedInteger& operator/=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator%=(const LargeUnsignedInteger& rhs);
-	LargeUnsignedInteger& operator%=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator<<=(const ull_t& rhs);
-	LargeUnsignedInteger& operator>>=(const ull_t& rhs);
-
-	LargeUnsignedInteger& operator++();	// prefix increment
-	LargeUnsignedInteger& operator--();	// prefix decrement
-
-	LargeUnsignedInteger operator++(int);	// postfix increment
-	LargeUnsignedInteger operator--(int);	// postfix decrement
-
-	LargeUnsignedInteger& operator=(const LargeUnsignedInteger& rhs);	// copy assignment
-	LargeUnsignedInteger& operator=(const ull_t& rhs);					// copy assignment scalar
-
-	LargeUnsignedInteger& operator=(LargeUnsignedInteger&& rhs);		// move assignment
-	LargeUnsignedInteger& operator=(ull_t&& rhs);						// move assignment scalar
-
-	friend std::ostream& operator<<(std::ostream& os, const LargeUnsignedInteger& rhs);
-	void print_debug(const std::string name) const;
-};
-
-
-#endif /* LARGEUNSIGNEDINTEGER_H_ */
+
+#ifndef LARGEUNSIGNEDINTEGER_H_
+#define LARGEUNSIGNEDINTEGER_H_
+
+
+#include <iostream>
+#include <charconv>
+#include <string>
+#include <utility>
+
+
+#define ULL_MAX 0xFFFF'FFFF'FFFF'FFFFull
+
+#define PRINT_DEBUG(obj) obj.print_debug(#obj)
+
+#define MIN(a, b) (a < b) ? (a) : (b)
+#define MAX(a, b) (a > b) ? (a) : (b)
+
+class LargeUnsignedInteger;
+class LargeUnsignedDivisor;
+class LargeUnsignedDigitGenerator;
+class LargeUnsignedDigitParser;
+class MontgomeryContext;
+
+using ull_t = unsigned long long;
+using u128_t = unsigned __int128;
+using quot_rem = std::pair<LargeUnsignedInteger, LargeUnsignedInteger>;
+
+
+
+class LargeUnsignedInteger {
+	friend class LargeUnsignedDivisor;
+	friend class LargeUnsignedDigitGenerator;
+	friend class LargeUnsignedDigitParser;
+	friend class MontgomeryContext;
+
+private:
+	unsigned int num_segments;
+	unsigned int capacity;	// allocated words of arr
+	ull_t* arr;	// little-endian
+	unsigned int* arr_half;
+
+	static bool is_separating_char(char c);
+	static unsigned char digit_value(char c);
+	void construct_string_bin(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
+	void construct_string_oct(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
+	void construct_string_dec(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
+	void construct_string_hex(std::string::const_iterator& itr, std::string::const_iterator& itr_end);
+	void construct_string_radix(std::string::const_iterator& itr, std::string::const_iterator& itr_end, unsigned int radix, const char* err);
+	bool set_str_radix(const char* sp, unsigned int len, unsigned int radix);
+	void set_str_pow2(const char* sp, unsigned int len, unsigned int bits);
+	static bool strip_digits(char* dp, unsigned int& dn, const char* sp, unsigned int len, unsigned int radix);
+#if defined(__x86_64__)
+	static bool strip_digits_sse2(char* dp, unsigned int& dn, const char* sp, unsigned int& i, unsigned int len, unsigned int radix);
+	static bool strip_digits_avx2(char* dp, unsigned int& dn, const char* sp, unsigned int& i, unsigned int len, unsigned int radix);
+	static ull_t dec_chunk_value_sse41(const char* sp);
+#endif
+	static ull_t dec_chunk_value(const char* sp);
+
+	void assign_arr(ull_t* arr_new);
+	void refresh_arr_half();
+
+	void reserve(unsigned int len);
+	void resize(unsigned int len);
+	void trim();
+
+	static ull_t add_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n);
+	static ull_t sub_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n);
+	static ull_t add_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v);
+	static ull_t sub_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v);
+	static ull_t add(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+	static ull_t sub(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+	static int cmp_n(const ull_t* up, const ull_t* vp, unsigned int n);
+	static bool abs_diff(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+	static ull_t submul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v);
+	static void neg_n(ull_t* rp, const ull_t* up, unsigned int n);
+	static ull_t lshift(ull_t* rp, const ull_t* up, unsigned int n, unsigned int cnt);
+	static ull_t rshift(ull_t* rp, const ull_t* up, unsigned int n, unsigned int cnt);
+	static void divexact_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t d);
+
+	static ull_t mul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v);
+	static ull_t addmul_1(ull_t* rp, const ull_t* up, unsigned int n, ull_t v);
+	static void mul_basecase(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+	static void mul(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+	static void mul(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn, ull_t* scratch);
+	static unsigned int mul_scratch_size(unsigned int un, unsigned int vn);
+	static unsigned int mul_toom_parts(unsigned int un, unsigned int vn);
+	static void mul_n(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n, ull_t* scratch);
+	static unsigned int mul_n_scratch_size(unsigned int n);
+	static void mul_karatsuba(ull_t* rp, const ull_t* up, const ull_t* vp, unsigned int n, ull_t* scratch);
+
+	static void sqr(ull_t* rp, const ull_t* up, unsigned int n);
+	static void sqr_n(ull_t* rp, const ull_t* up, unsigned int n, ull_t* scratch);
+	static void sqr_basecase(ull_t* rp, const ull_t* up, unsigned int n);
+	static void sqr_karatsuba(ull_t* rp, const ull_t* up, unsigned int n, ull_t* scratch);
+
+	static ull_t invert_limb(ull_t d);
+	static ull_t div_2by1(ull_t& r, ull_t u1, ull_t u0, ull_t d, ull_t v);
+	static ull_t invert_pi1(ull_t d1, ull_t d0, ull_t v);
+	static ull_t div_3by2(ull_t& r1, ull_t& r0, ull_t n2, ull_t n1, ull_t n0, ull_t d1, ull_t d0, ull_t v);
+	static ull_t div_1(ull_t* qp, const ull_t* up, unsigned int n, ull_t d);
+	static ull_t div_1_preinv(ull_t* qp, const ull_t* up, unsigned int n, ull_t d, unsigned int shift, ull_t v);
+	static ull_t mod_1(const ull_t* up, unsigned int n, ull_t d);
+	static ull_t mod_1_preinv(const ull_t* up, unsigned int n, ull_t d, unsigned int shift, ull_t v);
+	static ull_t div_basecase(ull_t* qp, ull_t* np, unsigned int nn, const ull_t* dp, unsigned int dn, ull_t v);
+	static ull_t div_dc_n(ull_t* qp, ull_t* np, const ull_t* dp, unsigned int n, ull_t v, ull_t* scratch);
+	static void div_dc(ull_t* qp, ull_t* np, unsigned int nn, const ull_t* dp, unsigned int dn, ull_t v);
+
+	static const unsigned int TOOM_MIN_SIZE;
+	static unsigned int toom_part_size(unsigned int un, unsigned int vn, unsigned int ku, unsigned int kv);
+	static long long toom_point(unsigned int i);
+	static unsigned int mul_toom_scratch_size(unsigned int un, unsigned int vn, unsigned int ku, unsigned int kv);
+	static void toom_eval(ull_t* ep, ull_t* op, const ull_t* up, unsigned int kp, unsigned int k, unsigned int s, ull_t j);
+	static void toom_divexact(ull_t* wp, unsigned int n, long long d);
+	static void toom_interpolate(ull_t* wp, const ull_t* winf, unsigned int d, unsigned int n);
+	static void mul_toom(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn, unsigned int ku, unsigned int kv, ull_t* scratch);
+
+	static const ull_t FFT_PRIMES[3];
+	static const ull_t FFT_GENERATORS[3];
+	static ull_t fft_mulmod(ull_t a, ull_t b, ull_t p, ull_t p_neg_inv);
+	static ull_t fft_powmod(ull_t a, ull_t e, ull_t p);
+	static void fft_forward(ull_t* ap, unsigned int len, const ull_t* roots, ull_t p, ull_t p_neg_inv);
+	static void fft_inverse(ull_t* ap, unsigned int len, const ull_t* roots, ull_t p, ull_t p_neg_inv);
+	static void fft_forward3(ull_t* ap, unsigned int m, ull_t w, ull_t omega, ull_t p, ull_t p_neg_inv);
+	static void fft_inverse3(ull_t* ap, unsigned int m, ull_t w, ull_t omega, ull_t p, ull_t p_neg_inv);
+	static void fft_crt(ull_t* rp, const ull_t* res, unsigned int rn);
+	static void mul_fft(ull_t* rp, const ull_t* up, unsigned int un, const ull_t* vp, unsigned int vn);
+
+	static const unsigned int DEC_CHUNK_DIGITS;
+	static const char DIGIT_CHARS[];
+	static const unsigned int RADIX_CHUNK_DIGITS[37];
+	static const ull_t RADIX_CHUNK[37];
+	static const unsigned int RADIX_POWERS_MAX = 32;	// cached radix powers per radix
+	static const LargeUnsignedInteger& radix_power(unsigned int radix, unsigned int k);
+	static void get_str(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int radix);
+	static void get_str_basecase(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int radix);
+	static void get_str_pow2(char* sp, unsigned int len, const LargeUnsignedInteger& u, unsigned int bits);
+	void set_str(const char* sp, unsigned int len, unsigned int radix);
+	void set_str_basecase(const char* sp, unsigned int len, unsigned int radix);
+
+	unsigned int bit_length() const;
+	bool get_bit(unsigned int i) const;
+	unsigned int get_window(unsigned int i, unsigned int k, unsigned int& w_bits) const;
+	static unsigned int powm_window_size(unsigned int e_bits);
+	static void sec_select(ull_t* rp, const ull_t* table, unsigned int tn, unsigned int n, ull_t w);
+	quot_rem div_mod_dc(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger reciprocal_approx(unsigned int n_bits) const;
+
+
+public:
+	static const unsigned int UINT_BITS;
+	static const unsigned int ULL_BITS;
+
+	// Words at which multiplication switches algorithm. Set to UINT_MAX to disable a tier
+	static unsigned int KARATSUBA_THRESHOLD;	// Karatsuba
+	static unsigned int TOOM33_THRESHOLD;		// Toom-3
+	static unsigned int TOOM44_THRESHOLD;		// Toom-4
+	static unsigned int TOOM32_THRESHOLD;		// Toom-32, for operands about 1.5 times longer
+	static unsigned int TOOM42_THRESHOLD;		// Toom-42, for operands about 2 times longer
+	static unsigned int FFT_THRESHOLD;			// three-prime NTT
+	static unsigned int FFT_RADIX3_THRESHOLD;	// NTT lengths 3 * 2^k as well as 2^k, for products this long
+
+	// Divisor words at which division switches algorithm. Set to UINT_MAX to disable a tier
+	static unsigned int DIV_DC_THRESHOLD;		// divide-and-conquer
+	static unsigned int DIV_NEWTON_THRESHOLD;	// Newton reciprocal, when the quotient is this long too
+
+	// Words at which conversion to and from non-power-of-two radixes switches to divide-and-conquer
+	static unsigned int DEC_DC_THRESHOLD;
+
+	static unsigned int fft_length(unsigned int rn);	// NTT length for a product of rn words
+
+	LargeUnsignedInteger();
+	LargeUnsignedInteger(ull_t num);
+	LargeUnsignedInteger(unsigned int len, const ull_t* nums);
+	LargeUnsignedInteger(const std::string& str);
+	LargeUnsignedInteger(const LargeUnsignedInteger& rhs);	// copy constructor
+	LargeUnsignedInteger(LargeUnsignedInteger&& rhs);		// move constructor
+	~LargeUnsignedInteger();								// destructor
+
+	unsigned int get_size() const;
+
+	bool is_zero() const;
+
+	void reset();
+	void set(ull_t num);
+	void set(unsigned int len, const ull_t* nums);
+	void set(const std::string& str);
+
+	ull_t get_low_word() const;
+
+	LargeUnsignedInteger operator+(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger operator+(const ull_t& rhs) const;
+
+	LargeUnsignedInteger operator-(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger operator-(const ull_t& rhs) const;
+
+	LargeUnsignedInteger operator*(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger operator*(const ull_t& rhs) const;
+
+	LargeUnsignedInteger square() const;
+
+	static LargeUnsignedInteger pow(const LargeUnsignedInteger& base, ull_t exp);
+
+	static LargeUnsignedInteger powm(const LargeUnsignedInteger& base, const LargeUnsignedInteger& exp, const LargeUnsignedInteger& mod);
+	static LargeUnsignedInteger powm_sec(const LargeUnsignedInteger& base, const LargeUnsignedInteger& exp, const LargeUnsignedInteger& mod);
+
+	quot_rem div_mod(const LargeUnsignedInteger& rhs) const;
+	quot_rem div_mod(const ull_t& rhs) const;
+	quot_rem div_mod(const LargeUnsignedInteger& rhs, const LargeUnsignedInteger& rhs_recip, unsigned int n_bits) const;
+	quot_rem div_mod(const LargeUnsignedDivisor& rhs) const;
+
+	LargeUnsignedInteger reciprocal(unsigned int n_bits) const;	// floor(2^n_bits / this)
+
+	LargeUnsignedInteger operator/(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger operator/(const ull_t& rhs) const;
+	LargeUnsignedInteger operator/(const LargeUnsignedDivisor& rhs) const;
+
+	LargeUnsignedInteger operator%(const LargeUnsignedInteger& rhs) const;
+	LargeUnsignedInteger operator%(const ull_t& rhs) const;
+	LargeUnsignedInteger operator%(const LargeUnsignedDivisor& rhs) const;
+
+	LargeUnsignedInteger operator<<(const ull_t& rhs) const;
+	LargeUnsignedInteger operator>>(const ull_t& rhs) const;
+
+	bool operator<(const LargeUnsignedInteger& rhs) const;
+	bool operator<(const ull_t& rhs) const;
+
+	bool operator>(const LargeUnsignedInteger& rhs) const;
+	bool operator>(const ull_t& rhs) const;
+
+	bool operator<=(const LargeUnsignedInteger& rhs) const;
+	bool operator<=(const ull_t& rhs) const;
+
+	bool operator>=(const LargeUnsignedInteger& rhs) const;
+	bool operator>=(const ull_t& rhs) const;
+
+	bool operator==(const LargeUnsignedInteger& rhs) const;
+	bool operator==(const ull_t& rhs) const;
+
+	bool operator!=(const LargeUnsignedInteger& rhs) const;
+	bool operator!=(const ull_t& rhs) const;
+
+	LargeUnsignedInteger& operator+=(const LargeUnsignedInteger& rhs);
+	LargeUnsignedInteger& operator+=(const ull_t& rhs);
+
+	LargeUnsignedInteger& operator-=(const LargeUnsignedInteger& rhs);
+	LargeUnsignedInteger& operator-=(const ull_t& rhs);
+
+	LargeUnsignedInteger& operator*=(const LargeUnsignedInteger& rhs);
+	LargeUnsignedInteger& operator*=(const ull_t& rhs);
+
+	LargeUnsignedInteger& addmul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b);	// this += a * b
+	LargeUnsignedInteger& addmul(const LargeUnsignedInteger& a, const ull_t& b);
+	LargeUnsignedInteger& submul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b);	// this -= a * b
+	LargeUnsignedInteger& submul(const LargeUnsignedInteger& a, const ull_t& b);
+
+	LargeUnsignedInteger& operator/=(const LargeUnsignedInteger& rhs);
+	LargeUnsignedInteger& operator/=(const ull_t& rhs);
+	LargeUnsignedInteger& operator/=(const LargeUnsignedDivisor& rhs);
+
+	LargeUnsignedInteger& operator%=(const LargeUnsignedInteger& rhs);
+	LargeUnsignedInteger& operator%=(const ull_t& rhs);
+	LargeUnsignedInteger& operator%=(const LargeUnsignedDivisor& rhs);
+
+	LargeUnsignedInteger& operator<<=(const ull_t& rhs);
+	LargeUnsignedInteger& operator>>=(const ull_t& rhs);
+
+	LargeUnsignedInteger& operator++();	// prefix increment
+	LargeUnsignedInteger& operator--();	// prefix decrement
+
+	LargeUnsignedInteger operator++(int);	// postfix increment
+	LargeUnsignedInteger operator--(int);	// postfix decrement
+
+	LargeUnsignedInteger& operator=(const LargeUnsignedInteger& rhs);	// copy assignment
+	LargeUnsignedInteger& operator=(const ull_t& rhs);					// copy assignment scalar
+
+	LargeUnsignedInteger& operator=(LargeUnsignedInteger&& rhs);		// move assignment
+	LargeUnsignedInteger& operator=(ull_t&& rhs);						// move assignment scalar
+
+	unsigned int max_chars(int base = 10) const;
+	std::to_chars_result to_chars(char* first, char* last, int base = 10) const;
+	std::from_chars_result from_chars(const char* first, const char* last, int base = 10);
+	std::string to_string(int base = 10) const;
+	void read(int fd, int base = 10);
+
+	friend std::ostream& operator<<(std::ostream& os, const LargeUnsignedInteger& rhs);
+	friend std::istream& operator>>(std::istream& is, LargeUnsignedInteger& rhs);	// dec, hex with optional 0x, or oct
+	void print_debug(const std::string name) const;
+};
+
+
+#endif /* LARGEUNSIGNEDINTEGER_H_ */
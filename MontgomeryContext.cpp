@@ -0,0 +1,284 @@
+#include "MontgomeryContext.h"
+#include <stdexcept>
+
+
+// Modulus Initializing Constructor
+MontgomeryContext::MontgomeryContext(const LargeUnsignedInteger& m) :
+		num_segments	{m.num_segments},
+		scratch_size	{LargeUnsignedInteger::mul_n_scratch_size(m.num_segments)},
+		modulus			{m},
+		mod_inv			{0},
+		arr				{nullptr}
+{
+	// Check modulus
+	if(!(m.arr[0] & 1)  ||  m == 1ull)
+		throw std::invalid_argument("Montgomery modulus must be odd and greater than 1.");
+
+	alloc();
+
+	unsigned int n = num_segments;
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		mod[i] = m.arr[i];
+
+	// Inverse of m modulo 2^64 by Newton iteration. m*m = 1 (mod 8) gives the first 3 bits
+	ull_t inv = m.arr[0];
+	for(unsigned int i = 0;  i < 5;  ++i)
+		inv *= 2 - m.arr[0] * inv;
+	mod_inv = -inv;
+
+	// R mod m and R^2 mod m, zero-padded to n words
+	LargeUnsignedInteger r_mod = (LargeUnsignedInteger{1ull} << static_cast<ull_t>(n * LargeUnsignedInteger::ULL_BITS)) % m;
+	LargeUnsignedInteger r2_mod = (LargeUnsignedInteger{1ull} << static_cast<ull_t>(2 * n * LargeUnsignedInteger::ULL_BITS)) % m;
+
+	for(unsigned int i = 0;  i < n;  ++i) {
+		one[i] = i < r_mod.num_segments ? r_mod.arr[i] : 0;
+		r2[i] = i < r2_mod.num_segments ? r2_mod.arr[i] : 0;
+	}
+}
+
+
+// Copy Constructor
+MontgomeryContext::MontgomeryContext(const MontgomeryContext& rhs) :
+		num_segments	{rhs.num_segments},
+		scratch_size	{rhs.scratch_size},
+		modulus			{rhs.modulus},
+		mod_inv			{rhs.mod_inv},
+		arr				{nullptr}
+{
+	alloc();
+
+	// Copy constant buffers
+	for(unsigned int i = 0;  i < 3 * num_segments;  ++i)
+		arr[i] = rhs.arr[i];
+}
+
+
+// Destructor
+MontgomeryContext::~MontgomeryContext() {
+	delete[] arr;
+}
+
+
+// Copy Assignment
+MontgomeryContext& MontgomeryContext::operator=(const MontgomeryContext& rhs) {
+	// Skip self-assignment
+	if(this != &rhs) {
+		delete[] arr;
+
+		num_segments = rhs.num_segments;
+		scratch_size = rhs.scratch_size;
+		modulus = rhs.modulus;
+		mod_inv = rhs.mod_inv;
+
+		alloc();
+
+		// Copy constant buffers
+		for(unsigned int i = 0;  i < 3 * num_segments;  ++i)
+			arr[i] = rhs.arr[i];
+	}
+
+	return *this;
+}
+
+
+// Allocate buffers for num_segments and scratch_size. Constant buffers come first
+void MontgomeryContext::alloc() {
+	unsigned int n = num_segments;
+
+	arr = new ull_t[5*n + scratch_size];
+	mod = arr;
+	r2 = arr + n;
+	one = arr + 2*n;
+	prod = arr + 3*n;
+	scratch = arr + 5*n;
+}
+
+
+// Get modulus size in words
+unsigned int MontgomeryContext::get_size() const {
+	return num_segments;
+}
+
+
+// Get modulus
+const LargeUnsignedInteger& MontgomeryContext::get_modulus() const {
+	return modulus;
+}
+
+
+// Get the Montgomery form of 1, n words
+const ull_t* MontgomeryContext::get_one() const {
+	return one;
+}
+
+
+// Convert a into Montgomery form a * R mod m
+void MontgomeryContext::to_mont(ull_t* rp, const ull_t* ap) {
+	mul(rp, ap, r2);
+}
+
+
+// Convert a out of Montgomery form, a * R^-1 mod m
+void MontgomeryContext::from_mont(ull_t* rp, const ull_t* ap) {
+	unsigned int n = num_segments;
+
+	for(unsigned int i = 0;  i < n;  ++i) {
+		prod[i] = ap[i];
+		prod[n+i] = 0;
+	}
+
+	redc(rp, prod);
+}
+
+
+// Montgomery product a * b * R^-1 mod m
+// Full product by the multiplication tiers, then word-by-word reduction
+void MontgomeryContext::mul(ull_t* rp, const ull_t* ap, const ull_t* bp) {
+	unsigned int n = num_segments;
+
+	if(scratch_size)
+		LargeUnsignedInteger::mul_n(prod, ap, bp, n, scratch);
+	else if(ap == bp)
+		LargeUnsignedInteger::sqr_basecase(prod, ap, n);
+	else
+		LargeUnsignedInteger::mul_basecase(prod, ap, n, bp, n);
+
+	redc(rp, prod);
+}
+
+
+// Montgomery square a * a * R^-1 mod m
+void MontgomeryContext::sqr(ull_t* rp, const ull_t* ap) {
+	unsigned int n = num_segments;
+
+	if(scratch_size)
+		LargeUnsignedInteger::sqr_n(prod, ap, n, scratch);
+	else
+		LargeUnsignedInteger::sqr_basecase(prod, ap, n);
+
+	redc(rp, prod);
+}
+
+
+// Montgomery reduction t * R^-1 mod m of 2n words of tp, where t < m * R
+// Each step adds the multiple of m that clears the lowest word, storing the carry-out word in its place. The high
+// half plus the carries is then less than 2m
+void MontgomeryContext::redc(ull_t* rp, ull_t* tp) {
+	unsigned int n = num_segments;
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		tp[i] = LargeUnsignedInteger::addmul_1(tp+i, mod, n, tp[i] * mod_inv);
+
+	ull_t carry = LargeUnsignedInteger::add_n(rp, tp+n, tp, n);
+
+	// Final subtraction
+	if(carry  ||  LargeUnsignedInteger::cmp_n(rp, mod, n) >= 0)
+		LargeUnsignedInteger::sub_n(rp, rp, mod, n);
+}
+
+
+// Constant-time Montgomery product a * b * R^-1 mod m
+// Schoolbook product only, since Karatsuba branches on operand differences
+void MontgomeryContext::mul_sec(ull_t* rp, const ull_t* ap, const ull_t* bp) {
+	LargeUnsignedInteger::mul_basecase(prod, ap, num_segments, bp, num_segments);
+	redc_sec(rp, prod);
+}
+
+
+// Constant-time Montgomery square a * a * R^-1 mod m
+void MontgomeryContext::sqr_sec(ull_t* rp, const ull_t* ap) {
+	LargeUnsignedInteger::sqr_basecase(prod, ap, num_segments);
+	redc_sec(rp, prod);
+}
+
+
+// Constant-time Montgomery reduction t * R^-1 mod m of 2n words of tp, where t < m * R
+// The final subtraction is always done, and its result selected by mask
+void MontgomeryContext::redc_sec(ull_t* rp, ull_t* tp) {
+	unsigned int n = num_segments;
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		tp[i] = LargeUnsignedInteger::addmul_1(tp+i, mod, n, tp[i] * mod_inv);
+
+	ull_t carry = LargeUnsignedInteger::add_n(rp, tp+n, tp, n);
+
+	// Low half of tp is free for the difference. Keep it on carry-out or no borrow
+	ull_t borrow = LargeUnsignedInteger::sub_n(tp, rp, mod, n);
+	ull_t mask = 0 - (carry | (borrow ^ 1));
+
+	for(unsigned int i = 0;  i < n;  ++i)
+		rp[i] = (tp[i] & mask) | (rp[i] & ~mask);
+}
+
+
+// Return a in Montgomery form. a is reduced modulo m first
+LargeUnsignedInteger MontgomeryContext::to_mont(const LargeUnsignedInteger& a) {
+	LargeUnsignedInteger a_mod = a < modulus ? a : a % modulus;
+	LargeUnsignedInteger rtn;
+
+	a_mod.resize(num_segments);
+	rtn.resize(num_segments);
+	to_mont(rtn.arr, a_mod.arr);
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return a out of Montgomery form
+LargeUnsignedInteger MontgomeryContext::from_mont(const LargeUnsignedInteger& a) {
+	LargeUnsignedInteger a_pad = a;
+	LargeUnsignedInteger rtn;
+
+	a_pad.resize(num_segments);
+	rtn.resize(num_segments);
+	from_mont(rtn.arr, a_pad.arr);
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the Montgomery product of a and b, both in Montgomery form
+LargeUnsignedInteger MontgomeryContext::mul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b) {
+	LargeUnsignedInteger a_pad = a;
+	LargeUnsignedInteger b_pad = b;
+	LargeUnsignedInteger rtn;
+
+	a_pad.resize(num_segments);
+	b_pad.resize(num_segments);
+	rtn.resize(num_segments);
+	mul(rtn.arr, a_pad.arr, b_pad.arr);
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the Montgomery square of a, in Montgomery form
+LargeUnsignedInteger MontgomeryContext::sqr(const LargeUnsignedInteger& a) {
+	LargeUnsignedInteger a_pad = a;
+	LargeUnsignedInteger rtn;
+
+	a_pad.resize(num_segments);
+	rtn.resize(num_segments);
+	sqr(rtn.arr, a_pad.arr);
+	rtn.trim();
+
+	return rtn;
+}
+
+
+// Return the Montgomery reduction t * R^-1 mod m, where t < m * R
+LargeUnsignedInteger MontgomeryContext::redc(const LargeUnsignedInteger& t) {
+	LargeUnsignedInteger t_pad = t;
+	LargeUnsignedInteger rtn;
+
+	t_pad.resize(2 * num_segments);
+	rtn.resize(num_segments);
+	redc(rtn.arr, t_pad.arr);
+	rtn.trim();
+
+	return rtn;
+}
@@ -0,0 +1,62 @@
+
+#ifndef MONTGOMERYCONTEXT_H_
+#define MONTGOMERYCONTEXT_H_
+
+
+#include "LargeUnsignedInteger.h"
+
+
+
+// Montgomery arithmetic modulo an odd n-word modulus m, with R = 2^(64n)
+// Word-array operations work on n-word buffers and reuse the context's scratch, so they don't allocate while n is
+// below FFT_THRESHOLD. From there mul() and sqr() take the NTT product, which allocates its own buffers; the
+// constant-time operations never allocate. A context must not be shared between threads; copy it instead
+class MontgomeryContext {
+private:
+	unsigned int num_segments;		// words of modulus
+	unsigned int scratch_size;		// words of multiplication scratch
+	LargeUnsignedInteger modulus;
+	ull_t mod_inv;					// -m^-1 mod 2^64
+	ull_t* arr;						// single allocation holding the buffers below
+	ull_t* mod;						// m, n words
+	ull_t* r2;						// R^2 mod m, n words
+	ull_t* one;						// R mod m, the Montgomery form of 1, n words
+	ull_t* prod;					// double-length product, 2n words
+	ull_t* scratch;					// multiplication scratch
+
+	void alloc();
+
+
+public:
+	MontgomeryContext(const LargeUnsignedInteger& m);
+	MontgomeryContext(const MontgomeryContext& rhs);	// copy constructor
+	~MontgomeryContext();								// destructor
+
+	MontgomeryContext& operator=(const MontgomeryContext& rhs);	// copy assignment
+
+	unsigned int get_size() const;
+	const LargeUnsignedInteger& get_modulus() const;
+	const ull_t* get_one() const;
+
+	// n-word buffers. Inputs must be less than m. rp may be equal to any input
+	void to_mont(ull_t* rp, const ull_t* ap);
+	void from_mont(ull_t* rp, const ull_t* ap);
+	void mul(ull_t* rp, const ull_t* ap, const ull_t* bp);
+	void sqr(ull_t* rp, const ull_t* ap);
+	void redc(ull_t* rp, ull_t* tp);	// tp is 2n words less than m * R, and is destroyed
+
+	// Constant-time n-word buffers, with no data-dependent branches or memory accesses
+	void mul_sec(ull_t* rp, const ull_t* ap, const ull_t* bp);
+	void sqr_sec(ull_t* rp, const ull_t* ap);
+	void redc_sec(ull_t* rp, ull_t* tp);
+
+	// Objects
+	LargeUnsignedInteger to_mont(const LargeUnsignedInteger& a);
+	LargeUnsignedInteger from_mont(const LargeUnsignedInteger& a);
+	LargeUnsignedInteger mul(const LargeUnsignedInteger& a, const LargeUnsignedInteger& b);
+	LargeUnsignedInteger sqr(const LargeUnsignedInteger& a);
+	LargeUnsignedInteger redc(const LargeUnsignedInteger& t);
+};
+
+
+#endif /* MONTGOMERYCONTEXT_H_ */
@@ -1,10 +1,16 @@
 
 #include "LargeUnsignedInteger.h"
+#include "LargeUnsignedDivisor.h"
+#include "MontgomeryContext.h"
+#include "LargeUnsignedDigitGenerator.h"
 #include <iostream>
 #include <string>
+#include <sstream>
 #include <iomanip>
 #include <utility>
 #include <chrono>
+#include <climits>
+#include <stdexcept>
 
 #define TEST_FUNC(func) test_wrapper(&func, #func)
 
@@ -58,6 +64,50 @@ void test_string_constructor() {
 	LargeUnsignedInteger d{str};
 	cout << str << endl;
 	PRINT_DEBUG(d);
+
+	// Long enough to split by powers of ten
+	str = "1" + string(2000, '0');
+	LargeUnsignedInteger e{str};
+	cout << (e == LargeUnsignedInteger::pow(LargeUnsignedInteger{10ull}, 2000)) << endl;
+
+	str = string(2000, '9');
+	e.set(str);
+	cout << (e + 1ull == LargeUnsignedInteger::pow(LargeUnsignedInteger{10ull}, 2000)) << endl;
+
+	// Power-of-two bases, with digits straddling words
+	str = "0x" + string(1000, 'f');
+	e.set(str);
+	cout << (e + 1ull == LargeUnsignedInteger{1ull} << 4000) << endl;
+
+	str = "0" + string(1000, '7');
+	e.set(str);
+	cout << (e + 1ull == LargeUnsignedInteger{1ull} << 3000) << endl;
+
+	str = "0b1" + string(1000, '0');
+	e.set(str);
+	cout << (e == LargeUnsignedInteger{1ull} << 1000) << endl;
+
+	// Separators and an invalid character inside 16 and 32-character blocks
+	e.set("0xFFFF'ffff'FFFF'ffff'0000'0000'0000'0001");
+	PRINT_DEBUG(e);
+
+	e.set("18'446'744'073'709'551'616'0'000'000'000'000'000'000");
+	cout << (e == (LargeUnsignedInteger{10'000'000'000'000'000'000ull} << 64)) << endl;
+
+	// Character below '0'
+	try {
+		e.set("12/34");
+	}
+	catch(const std::invalid_argument& ex) {
+		cout << ex.what() << endl;
+	}
+
+	try {
+		e.set("0x0123456789abcdef0123456789abcdeg");
+	}
+	catch(const std::invalid_argument& ex) {
+		cout << ex.what() << endl;
+	}
 }
 
 void test_copy_constructor() {
@@ -300,6 +350,250 @@ void test_multiplication_ull() {
 }
 
 
+void test_multiplication_karatsuba() {
+	constexpr unsigned int a_len = 100;
+	ull_t a_arr[a_len];
+	for(unsigned int i = 0;  i < a_len;  ++i)
+		a_arr[i] = ULL_MAX - i;
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 70;
+	ull_t b_arr[b_len];
+	for(unsigned int i = 0;  i < b_len;  ++i)
+		b_arr[i] = 0x0123456789abcdefull * (i + 1);
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	unsigned int threshold = LargeUnsignedInteger::KARATSUBA_THRESHOLD;
+
+	// Schoolbook product
+	LargeUnsignedInteger::KARATSUBA_THRESHOLD = a_len + 1;
+	LargeUnsignedInteger c = a * b;
+
+	// Karatsuba product
+	LargeUnsignedInteger::KARATSUBA_THRESHOLD = threshold;
+	LargeUnsignedInteger d = a * b;
+
+	cout << c.get_size() << " " << d.get_size() << endl;
+	cout << (c == d) << endl;
+}
+
+
+void test_multiplication_toom() {
+	constexpr unsigned int a_len = 200;
+	ull_t a_arr[a_len];
+	for(unsigned int i = 0;  i < a_len;  ++i)
+		a_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 90;
+	ull_t b_arr[b_len];
+	for(unsigned int i = 0;  i < b_len;  ++i)
+		b_arr[i] = 0x0123456789abcdefull * (i + 1);
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	LargeUnsignedInteger a_lo{b_len, a_arr};	// balanced operand
+	LargeUnsignedInteger a_mid{135, a_arr};		// operand 1.5 times longer
+
+	unsigned int* thresholds[] = {
+		&LargeUnsignedInteger::TOOM33_THRESHOLD,
+		&LargeUnsignedInteger::TOOM44_THRESHOLD,
+		&LargeUnsignedInteger::TOOM32_THRESHOLD,
+		&LargeUnsignedInteger::TOOM42_THRESHOLD
+	};
+	unsigned int saved[4];
+
+	// Reference products with every Toom tier disabled
+	for(unsigned int i = 0;  i < 4;  ++i) {
+		saved[i] = *thresholds[i];
+		*thresholds[i] = UINT_MAX;
+	}
+	LargeUnsignedInteger c = a_lo * b;
+	LargeUnsignedInteger d = a_mid * b;
+	LargeUnsignedInteger e = a * b;
+
+	// Enable one tier at a time
+	for(unsigned int i = 0;  i < 4;  ++i) {
+		*thresholds[i] = 32;
+		cout << (c == a_lo * b) << (d == a_mid * b) << (e == a * b) << endl;
+		*thresholds[i] = UINT_MAX;
+	}
+
+	for(unsigned int i = 0;  i < 4;  ++i)
+		*thresholds[i] = saved[i];
+}
+
+
+void test_multiplication_fft() {
+	constexpr unsigned int a_len = 3000;
+	ull_t* a_arr = new ull_t[a_len];
+	for(unsigned int i = 0;  i < a_len;  ++i)
+		a_arr[i] = (i % 3 == 0) ? ULL_MAX : 0x0123456789abcdefull * (i + 1);
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 2000;
+	ull_t* b_arr = new ull_t[b_len];
+	for(unsigned int i = 0;  i < b_len;  ++i)
+		b_arr[i] = ULL_MAX - i;
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	unsigned int threshold = LargeUnsignedInteger::FFT_THRESHOLD;
+	unsigned int radix3_threshold = LargeUnsignedInteger::FFT_RADIX3_THRESHOLD;
+
+	// Product without NTT
+	LargeUnsignedInteger::FFT_THRESHOLD = UINT_MAX;
+	LargeUnsignedInteger c = a * b;
+
+	// NTT product, of length 3 * 2^k
+	LargeUnsignedInteger::FFT_THRESHOLD = 1000;
+	LargeUnsignedInteger::FFT_RADIX3_THRESHOLD = 0;
+	LargeUnsignedInteger d = a * b;
+	cout << LargeUnsignedInteger::fft_length(a_len + b_len) << endl;
+
+	// NTT product, of length 2^k only
+	LargeUnsignedInteger::FFT_RADIX3_THRESHOLD = UINT_MAX;
+	LargeUnsignedInteger e = a * b;
+	cout << LargeUnsignedInteger::fft_length(a_len + b_len) << endl;
+
+	LargeUnsignedInteger::FFT_THRESHOLD = threshold;
+	LargeUnsignedInteger::FFT_RADIX3_THRESHOLD = radix3_threshold;
+
+	cout << (c == d) << " " << (c == e) << endl;
+
+	delete[] a_arr;
+	delete[] b_arr;
+}
+
+
+void test_square() {
+	constexpr unsigned int a_len = 3;
+	ull_t a_arr[a_len] = {ULL_MAX, 0x0123456789abcdefull, ULL_MAX};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	LargeUnsignedInteger b = a.square();
+	LargeUnsignedInteger c = a * a;
+	LargeUnsignedInteger d = a;
+	d *= d;
+	PRINT_DEBUG(a);
+	PRINT_DEBUG(b);
+	cout << (b == c) << (b == d) << endl;
+
+	// Long operand through the subquadratic squaring tiers
+	constexpr unsigned int e_len = 2000;
+	ull_t* e_arr = new ull_t[e_len];
+	for(unsigned int i = 0;  i < e_len;  ++i)
+		e_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger e{e_len, e_arr};
+	LargeUnsignedInteger f = e;
+
+	cout << (e.square() == e * f) << endl;
+
+	delete[] e_arr;
+}
+
+
+void test_pow() {
+	LargeUnsignedInteger a{3ull};
+
+	LargeUnsignedInteger b = LargeUnsignedInteger::pow(a, 100);
+	PRINT_DEBUG(b);
+
+	// Power of two is a shift
+	b = LargeUnsignedInteger::pow(LargeUnsignedInteger{2ull}, 130);
+	PRINT_DEBUG(b);
+	cout << (b == (LargeUnsignedInteger{1ull} << 130)) << endl;
+
+	// Against repeated multiplication, with trailing zero bits and a multi-word base
+	constexpr unsigned int c_len = 3;
+	ull_t c_arr[c_len] = {0ull, 0xfedcba9876543210ull, 0x0123456789abcdefull};
+	LargeUnsignedInteger c{c_len, c_arr};
+
+	for(ull_t base : {10ull, 12ull, 0x8000000000000000ull}) {
+		LargeUnsignedInteger d{base};
+		LargeUnsignedInteger e{1ull};
+		for(unsigned int i = 0;  i < 300;  ++i)
+			e *= d;
+		cout << (LargeUnsignedInteger::pow(d, 300) == e) << endl;
+	}
+
+	LargeUnsignedInteger f{1ull};
+	for(unsigned int i = 0;  i < 37;  ++i)
+		f *= c;
+	cout << (LargeUnsignedInteger::pow(c, 37) == f) << endl;
+
+	f = LargeUnsignedInteger::pow(c, 0);
+	PRINT_DEBUG(f);
+}
+
+
+void test_powm() {
+	LargeUnsignedInteger a{4ull};
+	LargeUnsignedInteger b{13ull};
+	LargeUnsignedInteger c{497ull};
+
+	LargeUnsignedInteger d = LargeUnsignedInteger::powm(a, b, c);
+	PRINT_DEBUG(d);
+
+	// Fermat's little theorem for the prime 2^127 - 1
+	constexpr unsigned int p_len = 2;
+	ull_t p_arr[p_len] = {ULL_MAX, 0x7fffffffffffffffull};
+	LargeUnsignedInteger p{p_len, p_arr};
+
+	constexpr unsigned int e_len = 3;
+	ull_t e_arr[e_len] = {0x0123456789abcdefull, ULL_MAX, 0xfedcba9876543210ull};
+	LargeUnsignedInteger e{e_len, e_arr};
+
+	LargeUnsignedInteger f = LargeUnsignedInteger::powm(e, p - 1ull, p);
+	PRINT_DEBUG(f);
+
+	// Even modulus against repeated multiplication
+	LargeUnsignedInteger m = p + 1ull;
+	LargeUnsignedInteger g = LargeUnsignedInteger::powm(e, LargeUnsignedInteger{1000ull}, m);
+	LargeUnsignedInteger h{1ull};
+	for(unsigned int i = 0;  i < 1000;  ++i)
+		h = h * e % m;
+	cout << (g == h) << endl;
+}
+
+
+void test_powm_sec() {
+	LargeUnsignedInteger a{4ull};
+	LargeUnsignedInteger b{13ull};
+	LargeUnsignedInteger c{497ull};
+
+	LargeUnsignedInteger d = LargeUnsignedInteger::powm_sec(a, b, c);
+	PRINT_DEBUG(d);
+
+	// Same results as the variable-time path, including leading zero windows and a zero exponent
+	constexpr unsigned int m_len = 4;
+	ull_t m_arr[m_len] = {0x0123456789abcdefull, ULL_MAX, 0ull, 0xfedcba9876543210ull};
+	LargeUnsignedInteger m{m_len, m_arr};
+
+	constexpr unsigned int e_len = 9;
+	ull_t e_arr[e_len] = {ULL_MAX, 0ull, 0x8000000000000001ull, 1ull, 2ull, 3ull, 4ull, 5ull, 1ull};
+	LargeUnsignedInteger e{e_len, e_arr};
+
+	LargeUnsignedInteger f = LargeUnsignedInteger::powm_sec(e, e, m);
+	LargeUnsignedInteger g = LargeUnsignedInteger::powm(e, e, m);
+	PRINT_DEBUG(f);
+	cout << (f == g) << endl;
+
+	f = LargeUnsignedInteger::powm_sec(e, LargeUnsignedInteger{}, m);
+	PRINT_DEBUG(f);
+
+	// Exponent shorter than the modulus, padded with zero words
+	f = LargeUnsignedInteger::powm_sec(e, b, m);
+	cout << (f == LargeUnsignedInteger::powm(e, b, m)) << endl;
+
+	// Even modulus
+	try {
+		f = LargeUnsignedInteger::powm_sec(a, b, m + 1ull);
+	}
+	catch(const std::invalid_argument& ex) {
+		cout << ex.what() << endl;
+	}
+}
+
+
 void test_div_mod_object() {
 	constexpr unsigned int a_len = 2;
 	ull_t a_arr[a_len] = {0ull, 1ull};
@@ -340,6 +634,33 @@ void test_div_mod_object() {
 	PRINT_DEBUG(b);
 	PRINT_DEBUG(qr.first);
 	PRINT_DEBUG(qr.second);
+
+	// Multi-word divisor. Quotient word estimates need the add-back correction
+	constexpr unsigned int c_len = 4;
+	ull_t c_arr[c_len] = {0ull, 0ull, 0x8000000000000000ull, 0x7fffffffffffffffull};
+	LargeUnsignedInteger c{c_len, c_arr};
+
+	constexpr unsigned int d_len = 3;
+	ull_t d_arr[d_len] = {1ull, 0ull, 0x8000000000000000ull};
+	LargeUnsignedInteger d{d_len, d_arr};
+
+	qr = c.div_mod(d);
+	PRINT_DEBUG(c);
+	PRINT_DEBUG(d);
+	PRINT_DEBUG(qr.first);
+	PRINT_DEBUG(qr.second);
+	cout << (qr.first * d + qr.second == c) << (qr.second < d) << endl;
+
+	// 4096-by-2048-bit division
+	constexpr unsigned int e_len = 64;
+	ull_t e_arr[e_len];
+	for(unsigned int i = 0;  i < e_len;  ++i)
+		e_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger e{e_len, e_arr};
+	LargeUnsignedInteger f = e >> 2048ull;
+
+	qr = e.div_mod(f);
+	cout << (qr.first * f + qr.second == e) << (qr.second < f) << endl;
 }
 
 
@@ -363,6 +684,197 @@ void test_div_mod_ull() {
 	cout << "0x" << std::hex << b << endl;
 	PRINT_DEBUG(qr.first);
 	PRINT_DEBUG(qr.second);
+
+	// Divisor with its top bit set, so no normalization shift
+	constexpr unsigned int c_len = 3;
+	ull_t c_arr[c_len] = {ULL_MAX, ULL_MAX, ULL_MAX};
+	LargeUnsignedInteger c{c_len, c_arr};
+
+	b = 0x8000000000000001ull;
+	qr = c.div_mod(b);
+	PRINT_DEBUG(c);
+	cout << "0x" << std::hex << b << endl;
+	PRINT_DEBUG(qr.first);
+	PRINT_DEBUG(qr.second);
+	cout << (qr.first * b + qr.second == c) << (c / b == qr.first) << (c % b == qr.second) << endl;
+}
+
+
+void test_div_mod_dc() {
+	constexpr unsigned int a_len = 500;
+	ull_t a_arr[a_len];
+	for(unsigned int i = 0;  i < a_len;  ++i)
+		a_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 170;
+	ull_t b_arr[b_len];
+	for(unsigned int i = 0;  i < b_len;  ++i)
+		b_arr[i] = 0x0123456789abcdefull * (i + 1);
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	unsigned int threshold = LargeUnsignedInteger::DIV_DC_THRESHOLD;
+
+	// Schoolbook division
+	LargeUnsignedInteger::DIV_DC_THRESHOLD = UINT_MAX;
+	quot_rem qr1 = a.div_mod(b);
+
+	// Divide-and-conquer division
+	LargeUnsignedInteger::DIV_DC_THRESHOLD = threshold;
+	quot_rem qr2 = a.div_mod(b);
+
+	cout << qr1.first.get_size() << " " << qr2.first.get_size() << endl;
+	cout << (qr1.first == qr2.first) << (qr1.second == qr2.second) << endl;
+	cout << (qr2.first * b + qr2.second == a) << (qr2.second < b) << endl;
+}
+
+
+void test_reciprocal() {
+	LargeUnsignedInteger a{3ull};
+	LargeUnsignedInteger b = a.reciprocal(130);
+	LargeUnsignedInteger pow = LargeUnsignedInteger{1ull} << 130ull;
+	PRINT_DEBUG(a);
+	PRINT_DEBUG(b);
+	cout << (a * b <= pow) << (a * (b + 1ull) > pow) << endl;
+
+	// Reciprocal reused across dividends
+	constexpr unsigned int c_len = 40;
+	ull_t c_arr[c_len];
+	for(unsigned int i = 0;  i < c_len;  ++i)
+		c_arr[i] = 0x0123456789abcdefull * (i + 1);
+	LargeUnsignedInteger c{c_len, c_arr};
+
+	unsigned int n_bits = 130 * LargeUnsignedInteger::ULL_BITS;
+	LargeUnsignedInteger c_recip = c.reciprocal(n_bits);
+	LargeUnsignedInteger d = (c << 2000ull) + 12345ull;
+	LargeUnsignedInteger e = c * c * c - 1ull;
+
+	quot_rem qr1 = d.div_mod(c, c_recip, n_bits);
+	quot_rem qr2 = e.div_mod(c, c_recip, n_bits);
+	cout << (qr1.first == d / c) << (qr1.second == d % c) << endl;
+	cout << (qr2.first == e / c) << (qr2.second == e % c) << endl;
+
+	// Newton division against long division
+	unsigned int threshold = LargeUnsignedInteger::DIV_NEWTON_THRESHOLD;
+	constexpr unsigned int f_len = 600;
+	ull_t f_arr[f_len];
+	for(unsigned int i = 0;  i < f_len;  ++i)
+		f_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger f{f_len, f_arr};
+	LargeUnsignedInteger g = (f >> 19000ull) + 1ull;
+
+	LargeUnsignedInteger::DIV_NEWTON_THRESHOLD = UINT_MAX;
+	quot_rem qr3 = f.div_mod(g);
+
+	LargeUnsignedInteger::DIV_NEWTON_THRESHOLD = 100;
+	quot_rem qr4 = f.div_mod(g);
+
+	LargeUnsignedInteger::DIV_NEWTON_THRESHOLD = threshold;
+	cout << qr3.first.get_size() << " " << qr4.first.get_size() << endl;
+	cout << (qr3.first == qr4.first) << (qr3.second == qr4.second) << endl;
+}
+
+
+void test_divisor() {
+	constexpr unsigned int a_len = 4;
+	ull_t a_arr[a_len] = {0x0123456789abcdefull, ULL_MAX, 0x8000000000000000ull, 0x0fedcba987654321ull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 2;
+	ull_t b_arr[b_len] = {ULL_MAX, 0x12345ull};
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	LargeUnsignedDivisor d{b};
+	quot_rem qr = a.div_mod(d);
+	PRINT_DEBUG(a);
+	PRINT_DEBUG(b);
+	PRINT_DEBUG(qr.first);
+	PRINT_DEBUG(qr.second);
+	cout << (qr.first == a / b) << (qr.second == a % b) << (a / d == qr.first) << (a % d == qr.second) << endl;
+
+	// Word-sized divisor
+	LargeUnsignedDivisor e{10ull};
+	cout << (a / e == a / 10ull) << (a % e == a % 10ull) << endl;
+
+	// Barrett reduction for long divisors
+	constexpr unsigned int f_len = 64;
+	ull_t f_arr[f_len];
+	for(unsigned int i = 0;  i < f_len;  ++i)
+		f_arr[i] = ULL_MAX - i * 0x0f0f0f0f0f0f0f0full;
+	LargeUnsignedInteger f{f_len, f_arr};
+	LargeUnsignedInteger g = (f >> 2000ull) + 1ull;
+
+	unsigned int threshold = LargeUnsignedDivisor::BARRETT_THRESHOLD;
+	LargeUnsignedDivisor::BARRETT_THRESHOLD = 16;
+	LargeUnsignedDivisor h{g};
+	LargeUnsignedDivisor::BARRETT_THRESHOLD = threshold;
+
+	LargeUnsignedInteger i = f;
+	i %= h;
+	cout << (f / h == f / g) << (i == f % g) << endl;
+
+	// Results into existing objects, reused across calls and aliasing the dividend
+	LargeUnsignedInteger q = f;
+	LargeUnsignedInteger r = f;
+	d.div_mod(a, q, r);
+	cout << (q == qr.first) << (r == qr.second);
+	d.rem(f, r);
+	cout << (r == f % b);
+	r = f;
+	d.rem(r, r);
+	cout << (r == f % b);
+	q = f;
+	d.div_mod(q, q, r);
+	cout << (q == f / b) << (r == f % b) << endl;
+}
+
+
+void test_montgomery() {
+	constexpr unsigned int m_len = 4;
+	ull_t m_arr[m_len] = {0xffffffff00000001ull, 0x0123456789abcdefull, ULL_MAX, 0x8000000000000000ull};
+	LargeUnsignedInteger m{m_len, m_arr};
+
+	constexpr unsigned int a_len = 4;
+	ull_t a_arr[a_len] = {ULL_MAX, ULL_MAX, ULL_MAX, 0x7fffffffffffffffull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	LargeUnsignedInteger b{0x0fedcba987654321ull};
+
+	MontgomeryContext ctx{m};
+	LargeUnsignedInteger a_mont = ctx.to_mont(a);
+	LargeUnsignedInteger b_mont = ctx.to_mont(b);
+	PRINT_DEBUG(m);
+	PRINT_DEBUG(a_mont);
+	PRINT_DEBUG(b_mont);
+
+	LargeUnsignedInteger c = ctx.from_mont(ctx.mul(a_mont, b_mont));
+	LargeUnsignedInteger d = ctx.from_mont(ctx.sqr(a_mont));
+	PRINT_DEBUG(c);
+	PRINT_DEBUG(d);
+	cout << (c == a * b % m) << (d == a * a % m) << (ctx.from_mont(a_mont) == a % m) << endl;
+
+	// Word buffers, reducing in place
+	ull_t x[m_len];
+	ull_t y[m_len];
+	for(unsigned int i = 0;  i < m_len;  ++i)
+		x[i] = a_arr[i];
+	ctx.to_mont(y, x);
+	for(unsigned int i = 0;  i < 10;  ++i)
+		ctx.sqr(y, y);
+	ctx.from_mont(y, y);
+
+	LargeUnsignedInteger e = a;
+	for(unsigned int i = 0;  i < 10;  ++i)
+		e = e * e % m;
+	cout << (LargeUnsignedInteger{m_len, y} == e) << endl;
+
+	// Even modulus is rejected
+	try {
+		MontgomeryContext{m + 1ull};
+	}
+	catch(const std::invalid_argument& e) {
+		cout << e.what() << endl;
+	}
 }
 
 
@@ -1006,6 +1518,59 @@ void test_multiplication_assign_object() {
 }
 
 
+void test_multiplication_assign_capacity() {
+	constexpr unsigned int a_len = 4;
+	ull_t a_arr[a_len] = {1ull, 2ull, 3ull, 4ull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	// Shrink value, keeping capacity
+	a >>= 192ull;
+	PRINT_DEBUG(a);
+
+	// Product fits existing capacity, so the array address is unchanged
+	LargeUnsignedInteger b{0x1000000000000001ull};
+	a *= b;
+	cout << "a *= b" << endl;
+	PRINT_DEBUG(a);
+
+	a *= a;
+	cout << "a *= a" << endl;
+	PRINT_DEBUG(a);
+}
+
+
+void test_multiplication_assign_long() {
+	constexpr unsigned int a_len = 40000;
+	ull_t* a_arr = new ull_t[a_len];
+	for(unsigned int i = 0;  i < a_len;  ++i)
+		a_arr[i] = 0x9e3779b97f4a7c15ull * (i+1);
+	LargeUnsignedInteger a{a_len, a_arr};
+	delete[] a_arr;
+
+	// Long this by one and two words, against the product object
+	constexpr unsigned int b_len = 2;
+	ull_t b_arr[b_len] = {ULL_MAX, 0x0123456789abcdefull};
+	LargeUnsignedInteger b{b_len, b_arr};
+	LargeUnsignedInteger c{ULL_MAX};
+
+	LargeUnsignedInteger d = a;
+	chrono::time_point<chrono::high_resolution_clock> t_start = chrono::high_resolution_clock::now();
+	d *= b;
+	d *= c;
+	chrono::time_point<chrono::high_resolution_clock> t_stop = chrono::high_resolution_clock::now();
+	cout << (d == a * b * c) << endl;
+	cout << "d *= b; d *= c:  " << chrono::duration_cast<chrono::microseconds>(t_stop - t_start).count() << " us" << endl;
+
+	// Long this by long rhs, and squared
+	d = a;
+	d *= a;
+	cout << (d == a * a) << endl;
+	d = b;
+	d *= a;
+	cout << (d == a * b) << endl;
+}
+
+
 void test_multiplication_assign_ull() {
 	constexpr unsigned int a_len = 2;
 	ull_t a_arr[a_len] = {1ull, 0x8000000000000001ull};
@@ -1021,6 +1586,49 @@ void test_multiplication_assign_ull() {
 }
 
 
+void test_addmul_submul() {
+	constexpr unsigned int a_len = 2;
+	ull_t a_arr[a_len] = {ULL_MAX, 0x0123456789abcdefull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	constexpr unsigned int b_len = 3;
+	ull_t b_arr[b_len] = {ULL_MAX, ULL_MAX, 1ull};
+	LargeUnsignedInteger b{b_len, b_arr};
+
+	LargeUnsignedInteger c{5ull};
+	PRINT_DEBUG(a);
+	PRINT_DEBUG(b);
+
+	c.addmul(a, b);
+	cout << "c.addmul(a, b)" << endl;
+	PRINT_DEBUG(c);
+	cout << (c == a * b + 5ull) << endl;
+
+	c.addmul(a, ULL_MAX);
+	cout << "c.addmul(a, ULL_MAX)" << endl;
+	PRINT_DEBUG(c);
+
+	c.submul(a, ULL_MAX);
+	c.submul(b, a);
+	cout << "c.submul(a, ULL_MAX); c.submul(b, a)" << endl;
+	PRINT_DEBUG(c);
+
+	// Operand aliasing the accumulator
+	LargeUnsignedInteger d = a;
+	d.addmul(d, d);
+	cout << (d == a + a * a) << endl;
+
+	// Long accumulator, with carries and borrows running through its all-ones and zero words
+	LargeUnsignedInteger e = (LargeUnsignedInteger{1ull} << 64000ull) - 1ull;
+	LargeUnsignedInteger f = e;
+	f.addmul(a, b);
+	cout << (f == e + a * b) << endl;
+	f.submul(a, b);
+	f.submul(b, a);
+	cout << (f == e - a * b) << endl;
+}
+
+
 void test_division_modulus_assign_object() {
 	constexpr unsigned int a_len = 3;
 	ull_t a_arr[a_len] = {0x0123456789abcdefull, ULL_MAX, ULL_MAX};
@@ -1300,11 +1908,192 @@ void test_move_assign_ull() {
 }
 
 
+void test_to_chars() {
+	constexpr unsigned int a_len = 2;
+	ull_t a_arr[a_len] = {0x0123456789abcdefull, 0xfedcba9876543210ull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	char buf[160];
+	to_chars_result res;
+
+	for(int base : {2, 8, 10, 16}) {
+		res = a.to_chars(buf, buf + sizeof(buf), base);
+		cout << base << " (" << a.max_chars(base) << "):  " << string(buf, res.ptr) << endl;
+	}
+
+	res = LargeUnsignedInteger{}.to_chars(buf, buf + sizeof(buf));
+	cout << string(buf, res.ptr) << endl;
+
+	// Buffer one character short
+	res = a.to_chars(buf, buf + 38);
+	cout << (res.ec == errc::value_too_large) << endl;
+
+	res = a.to_chars(buf, buf + 31, 16);
+	cout << (res.ec == errc::value_too_large) << endl;
+
+	res = a.to_chars(buf, buf + sizeof(buf), 37);
+	cout << (res.ec == errc::invalid_argument) << endl;
+}
+
+
+void test_to_string() {
+	constexpr unsigned int a_len = 2;
+	ull_t a_arr[a_len] = {0x0123456789abcdefull, 0xfedcba9876543210ull};
+	LargeUnsignedInteger a{a_len, a_arr};
+
+	for(int base : {2, 3, 7, 10, 16, 32, 36})
+		cout << base << ":  " << a.to_string(base) << endl;
+
+	// Round trip, long enough to split by radix powers
+	LargeUnsignedInteger b = LargeUnsignedInteger::pow(a, 40) - 1ull;
+	for(int base = 2;  base <= 36;  ++base) {
+		string str = b.to_string(base);
+		LargeUnsignedInteger c;
+		c.from_chars(str.data(), str.data() + str.size(), base);
+		if(c != b)
+			cout << "Mismatch in base " << base << endl;
+	}
+
+	cout << LargeUnsignedInteger{}.to_string(36) << endl;
+
+	try {
+		a.to_string(1);
+	}
+	catch(const std::invalid_argument& ex) {
+		cout << ex.what() << endl;
+	}
+}
+
+
+void test_digit_generator() {
+	constexpr unsigned int a_len = 2;
+	ull_t a_arr[a_len] = {0x0123456789abcdefull, 0xfedcba9876543210ull};
+	LargeUnsignedInteger a{a_len, a_arr};
+	char buf[64];
+	unsigned int n;
+
+	// Pieces of various lengths, long enough to split by radix powers
+	LargeUnsignedInteger b = LargeUnsignedInteger::pow(a, 40);
+	for(int base : {2, 3, 10, 16, 36}) {
+		LargeUnsignedDigitGenerator gen{b, base};
+		string str;
+		for(unsigned int len = 1;  !gen.done();  len = len % 37 + 1) {
+			n = gen.next(buf, len);
+			str.append(buf, n);
+		}
+		if(str != b.to_string(base))
+			cout << "Mismatch in base " << base << endl;
+	}
+
+	// Early termination
+	LargeUnsignedDigitGenerator gen{b};
+	n = gen.next(buf, 40);
+	cout << string(buf, n) << "..." << endl;
+
+	// Leading digits only, from one division of a value long enough to split
+	LargeUnsignedInteger c = LargeUnsignedInteger::pow(a, 400);
+	for(int base : {3, 10, 16}) {
+		string str = c.to_string(base);
+		for(unsigned int limit : {1u, 37u, 64u, 1000u, static_cast<unsigned int>(str.size())}) {
+			LargeUnsignedDigitGenerator lead{c, base, limit};
+			string prefix;
+			while(!lead.done()) {
+				n = lead.next(buf, 64);
+				prefix.append(buf, n);
+			}
+			if(prefix != str.substr(0, limit))
+				cout << "Leading digit mismatch in base " << base << " for " << limit << endl;
+		}
+	}
+
+	LargeUnsignedDigitGenerator zero{LargeUnsignedInteger{}};
+	n = zero.next(buf, 64);
+	cout << string(buf, n) << endl;
+
+	try {
+		LargeUnsignedDigitGenerator{a, 37};
+	}
+	catch(const std::invalid_argument& ex) {
+		cout << ex.what() << endl;
+	}
+}
+
+
+void test_from_chars() {
+	LargeUnsignedInteger a;
+	from_chars_result res;
+
+	string str = "340282366920938463463374607431768211455 trailing";
+	res = a.from_chars(str.data(), str.data() + str.size());
+	PRINT_DEBUG(a);
+	cout << "Stopped at:  \"" << res.ptr << "\"" << endl;
+
+	str = "FFFFffff00000000FFFFffff00000000x";
+	res = a.from_chars(str.data(), str.data() + str.size(), 16);
+	PRINT_DEBUG(a);
+	cout << "Stopped at:  \"" << res.ptr << "\"" << endl;
+
+	str = "1011012";
+	res = a.from_chars(str.data(), str.data() + str.size(), 2);
+	PRINT_DEBUG(a);
+	cout << "Stopped at:  \"" << res.ptr << "\"" << endl;
+
+	// No digits. Value is unchanged
+	str = "x123";
+	res = a.from_chars(str.data(), str.data() + str.size());
+	cout << (res.ec == errc::invalid_argument) << " " << (res.ptr == str.data()) << " " << a << endl;
+}
+
+
 void test_ostream() {
 	LargeUnsignedInteger a{"1234567890'1234567890'1234567890"};
 	PRINT_DEBUG(a);
 
 	cout << "\n" << a << endl;
+
+	// Zero, and around one word of digits
+	cout << LargeUnsignedInteger{} << endl;
+	cout << LargeUnsignedInteger{9'999'999'999'999'999'999ull} << endl;
+	cout << LargeUnsignedInteger{10'000'000'000'000'000'000ull} << endl;
+
+	// Long enough to split by powers of ten. All nines, then a one and zeros
+	LargeUnsignedInteger b = LargeUnsignedInteger::pow(LargeUnsignedInteger{10ull}, 2000);
+	ostringstream b_str;
+	b_str << b - 1ull;
+	cout << (b_str.str() == string(2000, '9')) << endl;
+
+	b_str.str("");
+	b_str << b;
+	cout << (b_str.str() == "1" + string(2000, '0')) << endl;
+}
+
+
+void test_istream() {
+	LargeUnsignedInteger a, b;
+
+	istringstream is{"  340282366920938463463374607431768211455 1234"};
+	is >> a >> b;
+	PRINT_DEBUG(a);
+	cout << b << "  eof: " << is.eof() << endl;
+
+	is.clear();
+	is.str("ffffffffffffffff0000000000000000 0XFf 0");
+	is >> hex >> a >> b;
+	PRINT_DEBUG(a);
+	cout << (b == 255ull);
+	is >> b >> dec;
+	cout << (b == 0ull) << "  eof: " << is.eof() << endl;
+
+	// Many blocks of digits. All nines
+	is.clear();
+	is.str(string(50000, '9') + " trailing");
+	is >> a;
+	cout << (a == LargeUnsignedInteger::pow(LargeUnsignedInteger{10ull}, 50000) - 1ull) << endl;
+
+	is.clear();
+	is.str("x");
+	is >> a;
+	cout << a << "  fail: " << is.fail() << endl;
 }
 
 
@@ -1359,6 +2148,61 @@ void time_ostream() {
 }
 
 
+void time_powm() {
+	constexpr unsigned int sets = 4;
+	const unsigned int reps = 10;
+	const unsigned int lens[sets] = {8, 16, 32, 64};
+	long long results[sets][2];
+
+	chrono::time_point<chrono::high_resolution_clock> t_start, t_stop;
+	chrono::duration<long long, chrono::microseconds::period> t_diff;
+
+	for(unsigned int i = 0;  i < sets;  ++i) {
+		unsigned int n = lens[i];
+		ull_t* arr = new ull_t[n];
+
+		for(unsigned int j = 0;  j < n;  ++j)
+			arr[j] = 0x9e3779b97f4a7c15ull * (j+1) + j;
+		arr[0] |= 1;
+		LargeUnsignedInteger m{n, arr};
+
+		for(unsigned int j = 0;  j < n;  ++j)
+			arr[j] = 0xc2b2ae3d27d4eb4full * (j+3);
+		LargeUnsignedInteger e{n, arr};
+
+		delete[] arr;
+
+		LargeUnsignedInteger b = m / 3ull;
+
+		// Variable-time, then constant-time
+		for(unsigned int k = 0;  k < 2;  ++k) {
+			t_start = chrono::high_resolution_clock::now();
+
+			for(unsigned int j = 0;  j < reps;  ++j) {
+				if(k == 0)
+					LargeUnsignedInteger::powm(b, e, m);
+				else
+					LargeUnsignedInteger::powm_sec(b, e, m);
+			}
+
+			t_stop = chrono::high_resolution_clock::now();
+			t_diff = chrono::duration_cast<chrono::microseconds>(t_stop - t_start);
+
+			results[i][k] = t_diff.count() / reps;
+		}
+	}
+
+	for(unsigned int i = 0;  i < sets;  ++i) {
+		cout << lens[i] * 64 << " bits:  ";
+		for(unsigned int k = 0;  k < 2;  ++k) {
+			cout << (k == 0 ? "powm " : "   powm_sec ") << results[i][k] / 1000 << ".";
+			cout << setw(3) << setfill('0') << results[i][k] % 1000 << " ms";
+		}
+		cout << endl;
+	}
+}
+
+
 int main() {
 //	TEST_FUNC(test_default_constructor);
 //	TEST_FUNC(test_scalar_constructor);
@@ -1384,9 +2228,20 @@ int main() {
 
 //	TEST_FUNC(test_multiplication_object);
 //	TEST_FUNC(test_multiplication_ull);
+//	TEST_FUNC(test_multiplication_karatsuba);
+//	TEST_FUNC(test_multiplication_toom);
+//	TEST_FUNC(test_multiplication_fft);
+//	TEST_FUNC(test_square);
+//	TEST_FUNC(test_pow);
+//	TEST_FUNC(test_powm);
+//	TEST_FUNC(test_powm_sec);
 
 //	TEST_FUNC(test_div_mod_object);
 //	TEST_FUNC(test_div_mod_ull);
+//	TEST_FUNC(test_div_mod_dc);
+//	TEST_FUNC(test_reciprocal);
+//	TEST_FUNC(test_divisor);
+//	TEST_FUNC(test_montgomery);
 //	TEST_FUNC(test_division_modulus_object);
 //	TEST_FUNC(test_division_modulus_ull);
 
@@ -1418,7 +2273,10 @@ int main() {
 //	TEST_FUNC(test_subtraction_assign_ull);
 
 //	TEST_FUNC(test_multiplication_assign_object);
+//	TEST_FUNC(test_multiplication_assign_capacity);
+//	TEST_FUNC(test_multiplication_assign_long);
 //	TEST_FUNC(test_multiplication_assign_ull);
+//	TEST_FUNC(test_addmul_submul);
 
 //	TEST_FUNC(test_division_modulus_assign_object);
 //	TEST_FUNC(test_division_modulus_assign_ull);
@@ -1438,4 +2296,10 @@ int main() {
 //	TEST_FUNC(test_move_assign_ull);
 
 	TEST_FUNC(test_ostream);
+//	TEST_FUNC(test_istream);
+//	TEST_FUNC(test_to_chars);
+//	TEST_FUNC(test_from_chars);
+//	TEST_FUNC(test_to_string);
+//	TEST_FUNC(test_digit_generator);
+//	TEST_FUNC(time_powm);
 }